@@ -23,12 +23,17 @@ Application
 Description
     Test code for rapid prototyping lsf-server output.
 
+    The LSF information can also be recorded to a directory and later
+    replayed from there, without requiring an LSF installation.
+
 \*---------------------------------------------------------------------------*/
 
+#include <cstring>
 #include <iostream>
 
 #include "lsfutil/LsfJobList.hpp"
 #include "lsfutil/LsfHostList.hpp"
+#include "lsfutil/LsfReplaySource.hpp"
 #include "lsfutil/OutputQhost.hpp"
 #include "lsfutil/OutputQstat.hpp"
 #include "lsfutil/OutputQstatJ.hpp"
@@ -36,10 +41,37 @@ Description
 
 int main(int argc, char **argv)
 {
+    if (argc == 3 && !strcmp(argv[1], "-record"))
+    {
+        if (!lsfutil::LsfReplaySource::record
+            (
+                argv[2],
+                lsfutil::LsfDataSource::defaultSource()
+            )
+        )
+        {
+            std::cerr
+                << "error recording to " << argv[2] << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // replay instead of using LSF
+    lsfutil::LsfReplaySource replay(argc > 2 ? argv[2] : "");
+    if (argc > 2 && !strcmp(argv[1], "-replay"))
+    {
+        lsfutil::LsfDataSource::defaultSource(&replay);
+        argc -= 2;
+        argv += 2;
+    }
+
     if (argc == 1)
     {
         std::cerr
-            << "no resource specified\n";
+            << "no resource specified\n\n"
+            << "usage: lsf-direct [-replay Dir] Resource\n"
+            << "       lsf-direct -record Dir\n";
         return 1;
     }
 
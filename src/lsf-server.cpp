@@ -34,15 +34,24 @@ SourceFiles
 
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
+#include <pthread.h>
+#include <algorithm>
 
 #include <set>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <unistd.h>
 
 #include "markutil/HttpServer.hpp"
+#include "markutil/HttpResponseCache.hpp"
+#include "markutil/Mutex.hpp"
+#include "markutil/SocketStream.hpp"
 #include "lsfutil/LsfHostList.hpp"
 #include "lsfutil/LsfJobList.hpp"
+#include "lsfutil/LsfReplaySource.hpp"
+#include "lsfutil/LsfSnapshotCache.hpp"
 #include "lsfutil/OutputQhost.hpp"
 #include "lsfutil/OutputQstat.hpp"
 #include "lsfutil/OutputQstatJ.hpp"
@@ -58,8 +67,354 @@ class LsfServer
 :
     public markutil::HttpServer
 {
+    // Private data
+
+        //- The process-wide LSF snapshot
+        lsfutil::LsfSnapshotCache& cache_;
+
+        //- The bodies rendered from the current snapshot
+        mutable markutil::HttpResponseCache responses_;
+
+        //- The pre-renderer thread
+        pthread_t prerenderer_;
+
+        //- Protects the pre-renderer state
+        mutable markutil::Mutex prerenderMutex_;
+
+        //- The pre-renderer thread is running, cleared to stop it
+        bool prerendering_;
+
+        //- The number of bodies rendered by the pre-renderer
+        unsigned long prerendered_;
+
+        //- The recording that the pre-forked workers replay, if any
+        lsfutil::LsfReplaySource* recording_;
+
+        //- The time the master last recorded for the pre-forked workers
+        time_t recorded_;
+
+        //- The pid of a pre-forked worker, which has its own snapshots
+        pid_t worker_;
+
+
+    // Private Member Types
+
+    //- Render a body from the snapshot for the query, flagged if stale
+    typedef void (*Renderer)
+    (
+        lsfutil::OutputBuffer&,
+        const QueryType&,
+        const lsfutil::LsfSnapshot&,
+        const bool stale
+    );
+
+
     // Private Member Functions
 
+    //- The current snapshot, or an invalid pointer after sending a 503.
+    //  Adds its age to the header and flags if it is stale.
+    lsfutil::LsfSnapshot::Ptr snapshot
+    (
+        std::ostream& os,
+        HeaderType& head,
+        bool& stale
+    ) const
+    {
+        lsfutil::LsfSnapshot::Ptr snap = cache_.snapshot(stale);
+
+        if (!snap.valid() || snap->hasError())
+        {
+            head(head._503_SERVICE_UNAVAILABLE);
+            head.print(os, true);
+
+            snap.reset();
+        }
+        else
+        {
+            head("Age", lsfutil::LsfCore::makeString(snap->age()));
+
+            if (stale)
+            {
+                head("Warning", "110 - \"Response is Stale\"");
+            }
+        }
+
+        return snap;
+    }
+
+
+    //- The path and normalized query, which determine the content
+    static std::string routeKey
+    (
+        const std::string& path,
+        const QueryType& query
+    )
+    {
+        return path + '?' + query.toString();
+    }
+
+
+    //- The path and normalized query of the request
+    static std::string routeKey(const RequestType& req)
+    {
+        return routeKey(req.path(), req.query());
+    }
+
+
+    //- Set the validators of a response rendered from the snapshot.
+    //  The entity tag is derived from the snapshot time and generation,
+    //  the path and the normalized query, which determine the content,
+    //  and whether it is gzip-compressed, plus the pre-forked worker.
+    //  Sends a 304 if the client already has it.
+    bool notModified
+    (
+        std::ostream& os,
+        HeaderType& head,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale
+    ) const
+    {
+        // FNV-1a
+        const std::string route = routeKey(head.request());
+        unsigned long hash = 2166136261UL;
+        for (std::string::size_type i = 0; i < route.size(); ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(route[i])) * 16777619UL;
+        }
+
+        // generations restart with the server, but the time the snapshot
+        // was taken does not. Both are the same in every forked process,
+        // but each pre-forked worker takes its own snapshots
+        std::ostringstream etag;
+        etag<< std::hex
+            << '"' << snap.updated() << '-' << snap.generation();
+
+        if (worker_)
+        {
+            etag<< '-' << worker_;
+        }
+
+        etag<< '-' << (hash & 0xFFFFFFFFUL) << (stale ? "-s" : "")
+            << (head.request().acceptsGzip() ? "-gz" : "") << '"';
+
+        head("Vary", "Accept-Encoding");
+
+        if (head.validate(etag.str(), snap.updated()))
+        {
+            os  << head;
+            return true;
+        }
+
+        return false;
+    }
+
+
+    //- Render the body from the snapshot and add it to the cache
+    markutil::HttpResponseCache::Ptr renderBody
+    (
+        const std::string& key,
+        const QueryType& query,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale,
+        Renderer render
+    ) const
+    {
+        lsfutil::OutputBuffer buf;
+        render(buf, query, snap, stale);
+
+        std::string content;
+        buf.swap(content);
+
+        markutil::HttpResponseCache::Ptr body
+        (
+            new markutil::HttpResponseCache::Body(content)
+        );
+        responses_.insert(key, snap.generation(), body);
+
+        return body;
+    }
+
+
+    //- Compress the body and add it to the cache,
+    //  invalid if the compression failed
+    markutil::HttpResponseCache::Ptr compressBody
+    (
+        const std::string& key,
+        const markutil::HttpResponseCache::Body& plain,
+        unsigned long generation
+    ) const
+    {
+        std::string content;
+        if
+        (
+            !markutil::HttpCore::gzip
+            (
+                content,
+                plain.content().data(),
+                plain.size()
+            )
+        )
+        {
+            return markutil::HttpResponseCache::Ptr();
+        }
+
+        markutil::HttpResponseCache::Ptr body
+        (
+            new markutil::HttpResponseCache::Body(content)
+        );
+        responses_.insert(key + ";gzip", generation, body);
+
+        return body;
+    }
+
+
+    //- Render the route and its compressed form into the cache
+    void prerender
+    (
+        const std::string& path,
+        const lsfutil::LsfSnapshot& snap,
+        Renderer render
+    )
+    {
+        const QueryType unfiltered;
+        const std::string key = routeKey(path, unfiltered);
+
+        markutil::HttpResponseCache::Ptr body =
+            renderBody(key, unfiltered, snap, false, render);
+
+        compressBody(key, *body, snap.generation());
+
+        markutil::Mutex::Lock lock(prerenderMutex_);
+        prerendered_ += 2;
+    }
+
+
+    //- Render the hot routes of the snapshot into the cache
+    void prerender(const lsfutil::LsfSnapshot& snap)
+    {
+        if (!snap.hasError())
+        {
+            prerender("/qstat.xml", snap, render_qstat_xml);
+            prerender("/qhost.xml", snap, render_qhost_xml);
+            prerender("/qstatj.xml", snap, render_qstatj_xml);
+        }
+    }
+
+
+    //- True while the pre-renderer thread should keep running
+    bool prerendering() const
+    {
+        markutil::Mutex::Lock lock(prerenderMutex_);
+        return prerendering_;
+    }
+
+
+    //- Entry point for the pre-renderer thread
+    static void* prerenderer(void* arg)
+    {
+        static_cast<LsfServer*>(arg)->prerender();
+        return NULL;
+    }
+
+
+    //- Render the unfiltered xml as soon as each snapshot is swapped in,
+    //  so that the first request after a refresh finds it ready
+    void prerender()
+    {
+        unsigned long generation = 0;
+
+        while (prerendering())
+        {
+            lsfutil::LsfSnapshot::Ptr snap = cache_.waitNewer(generation, 1);
+            if (!snap.valid())
+            {
+                continue;
+            }
+
+            generation = snap->generation();
+            prerender(*snap);
+        }
+    }
+
+
+    //- Send the response with the body rendered from the snapshot,
+    //  gzip-compressed if the client accepts it.
+    //  Each route is rendered (and compressed) once per snapshot,
+    //  repeated requests send the cached body without copying it.
+    void sendBody
+    (
+        std::ostream& os,
+        HeaderType& head,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale,
+        Renderer render
+    ) const
+    {
+        const RequestType& req = head.request();
+        const unsigned long generation = snap.generation();
+
+        bool gzipped = req.acceptsGzip();
+
+        markutil::HttpResponseCache::Ptr body;
+        if (req.type() == req.GET)
+        {
+            const std::string key = routeKey(req) + (stale ? "-s" : "");
+
+            if (gzipped)
+            {
+                body = responses_.lookup(key + ";gzip", generation);
+            }
+
+            if (!body.valid())
+            {
+                body = responses_.lookup(key, generation);
+                if (!body.valid())
+                {
+                    body = renderBody(key, req.query(), snap, stale, render);
+                }
+
+                if (gzipped)
+                {
+                    markutil::HttpResponseCache::Ptr compressed =
+                        compressBody(key, *body, generation);
+
+                    if (compressed.valid())
+                    {
+                        body = compressed;
+                    }
+                    else
+                    {
+                        gzipped = false;
+                    }
+                }
+            }
+        }
+
+        if (gzipped)
+        {
+            head("Content-Encoding", "gzip");
+        }
+
+        os  << head(head._200_OK);
+
+        if (!body.valid())
+        {
+            return;
+        }
+
+        markutil::SocketStream* sock =
+            dynamic_cast<markutil::SocketStream*>(&os);
+        if (sock)
+        {
+            sock->sendBuffer(body->content().data(), body->size(), body.get());
+        }
+        else
+        {
+            os.write(body->content().data(), body->size());
+        }
+    }
+
+
     static std::set<std::string>& addToFilter
     (
         std::set<std::string>& filter,
@@ -101,23 +456,74 @@ class LsfServer
     }
 
 
-    template<class SomeT>
-    static bool intersectsFilter
+    // the job ids of a filter, sorted.
+    // An entry only matches if it is written exactly as the job id
+    static std::vector<int> toJobIds(const std::set<std::string>& filter)
+    {
+        std::vector<int> ids;
+
+        for
+        (
+            std::set<std::string>::const_iterator iter = filter.begin();
+            iter != filter.end();
+            ++iter
+        )
+        {
+            const int id = int(strtol(iter->c_str(), NULL, 10));
+            if (lsfutil::LsfCore::makeString(id) == *iter)
+            {
+                ids.push_back(id);
+            }
+        }
+
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+
+    // a table by string pool id, non-zero for the names in the set.
+    // Unknown names are not in the pool, and match nothing
+    static void markIds
     (
+        std::vector<unsigned char>& table,
         const std::set<std::string>& s,
-        const std::map<std::string, SomeT>& m
+        const lsfutil::LsfStringPool& pool
+    )
+    {
+        table.assign(pool.size(), 0);
+
+        for
+        (
+            std::set<std::string>::const_iterator iter = s.begin();
+            iter != s.end();
+            ++iter
+        )
+        {
+            const unsigned id = pool.find(*iter);
+            if (id < pool.size())
+            {
+                table[id] = 1;
+            }
+        }
+    }
+
+
+    static bool intersectsFilter
+    (
+        const std::vector<unsigned char>& resourceIds,
+        const lsfutil::LsfRusage& rusage
     )
     {
         bool matched = false;
 
         for
         (
-            typename std::map<std::string, SomeT>::const_iterator iter = m.begin();
-            !matched && iter != m.end();
+            lsfutil::LsfRusage::const_iterator iter = rusage.begin();
+            !matched && iter != rusage.end();
             ++iter
         )
         {
-            matched = s.count(iter->first);
+            matched = resourceIds[iter->name];
         }
 
         return matched;
@@ -126,109 +532,121 @@ class LsfServer
 
     int serve_blsof(std::ostream& os, HeaderType& head) const
     {
-        lsfutil::LsfJobList jobs;
-
-        if (jobs.hasError())
+        bool stale;
+        lsfutil::LsfSnapshot::Ptr snap = snapshot(os, head, stale);
+        if (!snap.valid())
         {
-            head(head._503_SERVICE_UNAVAILABLE);
-            head.print(os, true);
-
             return 1;
         }
+        else if (notModified(os, head, *snap, stale))
+        {
+            return 0;
+        }
 
         head.contentType("txt");
-        os  << head(head._200_OK);
+        sendBody(os, head, *snap, stale, render_blsof);
 
-        if (head.request().type() == head.request().GET)
-        {
-            const QueryType& query = head.request().query();
+        return 0;
+    }
 
-            std::set<std::string> jobFilter;
-            std::set<std::string> userFilter;
-            std::set<std::string> rusageFilter;
 
-            addToFilter(jobFilter, query, "jobid");
-            addToFilter(rusageFilter, query, "resources");
-            addToFilter(userFilter, query, "owner");
-            addToFilter(userFilter, query, "user");
+    static void render_blsof
+    (
+        lsfutil::OutputBuffer& os,
+        const QueryType& query,
+        const lsfutil::LsfSnapshot& snap,
+        const bool
+    )
+    {
+        const lsfutil::LsfJobList& jobs = snap.jobs();
 
-            // if userFilter has 'all' this is the same as no filter
-            // also respect '*' as per GridEngine
-            if (userFilter.count("all") || userFilter.count("*"))
-            {
-                userFilter.clear();
-            }
+        std::set<std::string> jobFilter;
+        std::set<std::string> userFilter;
+        std::set<std::string> rusageFilter;
 
-            // display pending jobs too?
-            bool withPending = false;
-            if (query.foundUnnamed("wait"))
-            {
-                withPending = true;
-            }
-            else if (query.found("wait"))
-            {
-                const QueryType::string_list& list = query.param("wait");
-                for
-                (
-                    QueryType::string_list::const_iterator iter = list.begin();
-                    iter != list.end();
-                    ++iter
-                )
-                {
-                    if (*iter == "true")
-                    {
-                        withPending = true;
-                        break;
-                    }
-                }
-            }
+        addToFilter(jobFilter, query, "jobid");
+        addToFilter(rusageFilter, query, "resources");
+        addToFilter(userFilter, query, "owner");
+        addToFilter(userFilter, query, "user");
 
-            // filter job-list based on query parameters
-            std::vector<int> displayJob;
-            displayJob.reserve(jobs.size());
+        // if userFilter has 'all' this is the same as no filter
+        // also respect '*' as per GridEngine
+        if (userFilter.count("all") || userFilter.count("*"))
+        {
+            userFilter.clear();
+        }
 
+        // the job owners and the requested resources are string pool ids,
+        // so resolve the names once
+        const lsfutil::LsfStringPool& strings = jobs.strings();
+        std::vector<unsigned char> userIds;
+        std::vector<unsigned char> resourceIds;
+        if (!userFilter.empty())
+        {
+            markIds(userIds, userFilter, strings);
+        }
+        if (!rusageFilter.empty())
+        {
+            markIds(resourceIds, rusageFilter, strings);
+        }
+
+        // display pending jobs too?
+        bool withPending = false;
+        if (query.foundUnnamed("wait"))
+        {
+            withPending = true;
+        }
+        else if (query.found("wait"))
+        {
+            const QueryType::string_list& list = query.param("wait");
             for
             (
-                unsigned jobI = 0;
-                jobI < jobs.size();
-                ++jobI
+                QueryType::string_list::const_iterator iter = list.begin();
+                iter != list.end();
+                ++iter
             )
             {
-                const lsfutil::LsfJobEntry& job = jobs[jobI];
-
-                // filter based on owner criterion
-                if (!userFilter.empty() && !userFilter.count(job.user))
+                if (*iter == "true")
                 {
-                    continue;
+                    withPending = true;
+                    break;
                 }
+            }
+        }
 
+        // filter job-list based on query parameters,
+        // first over the job columns
+        const lsfutil::LsfJobColumns& columns = snap.jobColumns();
 
-                // filter based on job id criterion
-                if (!jobFilter.empty() && !jobFilter.count(job.tokenJ()))
-                {
-                    continue;
-                }
+        lsfutil::LsfJobColumns::Mask mask;
+        columns.selectAll(mask);
 
+        columns.keepStates
+        (
+            mask,
+            (1u << lsfutil::LsfJobEntry::RUNNING)
+          | (withPending ? (1u << lsfutil::LsfJobEntry::PENDING) : 0)
+        );
 
-                // filter based on resource requests
-                if (!rusageFilter.empty())
-                {
-                    lsfutil::LsfCore::rusage_map resReq
-                        = lsfutil::LsfCore::parseRusage(job.submit.resReq);
+        // filter based on owner criterion
+        if (!userFilter.empty())
+        {
+            columns.keepUsers(mask, userIds);
+        }
 
-                    if (!intersectsFilter(rusageFilter, resReq))
-                    {
-                        continue;
-                    }
-                }
+        // filter based on job id criterion
+        if (!jobFilter.empty())
+        {
+            columns.keepJobIds(mask, toJobIds(jobFilter));
+        }
 
-                // we got this far, keep it
-                if (job.isRunning() || (withPending && job.isPending()))
-                {
-                    displayJob.push_back(jobI);
-                }
-            }
+        std::vector<int> displayJob;
+        lsfutil::LsfJobColumns::selected(mask, displayJob);
 
+        // filter based on resource requests
+        if (!rusageFilter.empty())
+        {
+            unsigned nKeep = 0;
             for
             (
                 unsigned displayI = 0;
@@ -238,145 +656,188 @@ class LsfServer
             {
                 const lsfutil::LsfJobEntry& job = jobs[displayJob[displayI]];
 
-                os  << job.cwd << " "
-                    << job.submit.outFile << " "
-                    << job.jobId << "\n";
+                if (intersectsFilter(resourceIds, job.submit.rusage))
+                {
+                    displayJob[nKeep++] = displayJob[displayI];
+                }
             }
-
+            displayJob.resize(nKeep);
         }
 
-        return 0;
+        for
+        (
+            unsigned displayI = 0;
+            displayI < displayJob.size();
+            ++displayI
+        )
+        {
+            const lsfutil::LsfJobEntry& job = jobs[displayJob[displayI]];
+
+            os  << job.cwd << " "
+                << job.submit.outFile << " "
+                << job.jobId << "\n";
+        }
     }
 
 
     int serve_dump(std::ostream& os, HeaderType& head) const
     {
-        lsfutil::LsfJobList jobs;
-
-        if (jobs.hasError())
+        bool stale;
+        lsfutil::LsfSnapshot::Ptr snap = snapshot(os, head, stale);
+        if (!snap.valid())
         {
-            head(head._503_SERVICE_UNAVAILABLE);
-            head.print(os, true);
-
             return 1;
         }
-
-        head.contentType("txt");
-        os  << head(head._200_OK);
-
-        if (head.request().type() == head.request().GET)
+        else if (notModified(os, head, *snap, stale))
         {
-            lsfutil::LsfJobList jobs;
-            jobs.dump(os);
+            return 0;
         }
 
+        head.contentType("txt");
+        sendBody(os, head, *snap, stale, render_dump);
+
         return 0;
     }
 
 
-    int serve_qhost_xml(std::ostream& os, HeaderType& head) const
+    static void render_dump
+    (
+        lsfutil::OutputBuffer& os,
+        const QueryType&,
+        const lsfutil::LsfSnapshot& snap,
+        const bool
+    )
     {
-        lsfutil::LsfJobList jobs;
-        lsfutil::LsfHostList hosts;
+        std::ostringstream oss;
+        snap.jobs().dump(oss);
+
+        os  << oss.str();
+    }
 
-        if (jobs.hasError() || hosts.hasError())
-        {
-            head(head._503_SERVICE_UNAVAILABLE);
-            head.print(os, true);
 
+    int serve_qhost_xml(std::ostream& os, HeaderType& head) const
+    {
+        bool stale;
+        lsfutil::LsfSnapshot::Ptr snap = snapshot(os, head, stale);
+        if (!snap.valid())
+        {
             return 1;
         }
-
-        head.contentType("xml");
-        os  << head(head._200_OK);
-
-        if (head.request().type() == head.request().GET)
+        else if (notModified(os, head, *snap, stale))
         {
-            lsfutil::OutputQhost::print(os, hosts, jobs);
+            return 0;
         }
 
+        head.contentType("xml");
+        sendBody(os, head, *snap, stale, render_qhost_xml);
+
         return 0;
     }
 
 
-    int serve_qstat_xml(std::ostream& os, HeaderType& head) const
+    static void render_qhost_xml
+    (
+        lsfutil::OutputBuffer& os,
+        const QueryType&,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale
+    )
     {
-        lsfutil::LsfJobList jobs;
+        lsfutil::OutputQhost::print
+        (
+            os,
+            snap.hosts(),
+            snap.jobs(),
+            snap.hostJobs(),
+            stale
+        );
+    }
 
-        if (jobs.hasError())
-        {
-            head(head._503_SERVICE_UNAVAILABLE);
-            head.print(os, true);
 
+    int serve_qstat_xml(std::ostream& os, HeaderType& head) const
+    {
+        bool stale;
+        lsfutil::LsfSnapshot::Ptr snap = snapshot(os, head, stale);
+        if (!snap.valid())
+        {
             return 1;
         }
-
-        head.contentType("xml");
-        os  << head(head._200_OK);
-
-        if (head.request().type() == head.request().GET)
+        else if (notModified(os, head, *snap, stale))
         {
-            lsfutil::OutputQstat::print(os, jobs);
+            return 0;
         }
 
+        head.contentType("xml");
+        sendBody(os, head, *snap, stale, render_qstat_xml);
+
         return 0;
     }
 
 
-    int serve_qstatj_xml(std::ostream& os, HeaderType& head) const
+    static void render_qstat_xml
+    (
+        lsfutil::OutputBuffer& os,
+        const QueryType&,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale
+    )
     {
-        lsfutil::LsfJobList jobs;
+        lsfutil::OutputQstat::print(os, snap.jobs(), stale);
+    }
 
-        if (jobs.hasError())
-        {
-            head(head._503_SERVICE_UNAVAILABLE);
-            head.print(os, true);
 
+    int serve_qstatj_xml(std::ostream& os, HeaderType& head) const
+    {
+        bool stale;
+        lsfutil::LsfSnapshot::Ptr snap = snapshot(os, head, stale);
+        if (!snap.valid())
+        {
             return 1;
         }
+        else if (notModified(os, head, *snap, stale))
+        {
+            return 0;
+        }
 
         head.contentType("xml");
-        os  << head(head._200_OK);
+        sendBody(os, head, *snap, stale, render_qstatj_xml);
 
-        if (head.request().type() == head.request().GET)
-        {
-            const QueryType& query = head.request().query();
+        return 0;
+    }
 
-            std::set<std::string> jobFilter;
 
-            addToFilter(jobFilter, query, "jobid");
+    static void render_qstatj_xml
+    (
+        lsfutil::OutputBuffer& os,
+        const QueryType& query,
+        const lsfutil::LsfSnapshot& snap,
+        const bool stale
+    )
+    {
+        const lsfutil::LsfJobList& jobs = snap.jobs();
 
-            if (!jobFilter.empty())
-            {
-                // filter job-list based on query parameters
-                std::vector<int> displayJob;
-                displayJob.reserve(jobs.size());
+        std::set<std::string> jobFilter;
 
-                for
-                (
-                    unsigned jobI = 0;
-                    jobI < jobs.size();
-                    ++jobI
-                )
-                {
-                    const lsfutil::LsfJobEntry& job = jobs[jobI];
+        addToFilter(jobFilter, query, "jobid");
 
-                    // filter based on job id criterion
-                    if (jobFilter.count(job.tokenJ()))
-                    {
-                        displayJob.push_back(jobI);
-                    }
-                }
+        if (!jobFilter.empty())
+        {
+            // filter job-list based on query parameters
+            const lsfutil::LsfJobColumns& columns = snap.jobColumns();
 
-                lsfutil::OutputQstatJ::print(os, jobs, displayJob);
-            }
-            else
-            {
-                lsfutil::OutputQstatJ::print(os, jobs);
-            }
-        }
+            lsfutil::LsfJobColumns::Mask mask;
+            columns.selectAll(mask);
+            columns.keepJobIds(mask, toJobIds(jobFilter));
 
-        return 0;
+            std::vector<int> displayJob;
+            lsfutil::LsfJobColumns::selected(mask, displayJob);
+
+            lsfutil::OutputQstatJ::print(os, jobs, displayJob, stale);
+        }
+        else
+        {
+            lsfutil::OutputQstatJ::print(os, jobs, stale);
+        }
     }
 
 
@@ -403,16 +864,123 @@ public:
 
     // Constructors
 
-        //! Create a server on specified port
-        LsfServer(unsigned short port, const std::string& root)
+        //! Create a server on specified port, serving from the snapshot cache
+        LsfServer
+        (
+            unsigned short port,
+            const std::string& root,
+            lsfutil::LsfSnapshotCache& cache
+        )
         :
-            ParentClass(port)
+            ParentClass(port),
+            cache_(cache),
+            responses_(),
+            prerenderer_(),
+            prerenderMutex_(),
+            prerendering_(false),
+            prerendered_(0),
+            recording_(NULL),
+            recorded_(0),
+            worker_(0)
         {
             this->name("lsf-utils");
             this->root(root);
         }
 
 
+    //- Destructor, stops the pre-renderer
+    virtual ~LsfServer()
+    {
+        bool running;
+        {
+            markutil::Mutex::Lock lock(prerenderMutex_);
+            running = prerendering_;
+            prerendering_ = false;
+        }
+
+        if (running)
+        {
+            ::pthread_join(prerenderer_, NULL);
+        }
+    }
+
+
+    // Member Functions
+
+        //- Start pre-rendering the unfiltered xml of each new snapshot.
+        //  Only useful while the snapshot cache is refreshing in the
+        //  background and the responses are served by this process.
+        bool startPrerender()
+        {
+            // the new thread only reads the flag once it has been set
+            markutil::Mutex::Lock lock(prerenderMutex_);
+
+            if (!prerendering_)
+            {
+                prerendering_ = true;
+                if (::pthread_create(&prerenderer_, NULL, prerenderer, this))
+                {
+                    prerendering_ = false;
+                }
+            }
+
+            return prerendering_;
+        }
+
+
+        //- Have the pre-forked workers replay the LSF information that
+        //  the master records into the given directory, instead of each
+        //  of them querying LSF. Records it for the first time.
+        //  \return false if the recording failed
+        bool recordFor(lsfutil::LsfReplaySource& recording)
+        {
+            recording_ = &recording;
+            recorded_ = time(0);
+
+            return lsfutil::LsfReplaySource::record
+            (
+                recording_->dir(),
+                lsfutil::LsfDataSource::defaultSource()
+            );
+        }
+
+
+        //- Each pre-forked worker refreshes and pre-renders its own
+        //  snapshots, from the recording of the master if there is one
+        virtual void process_init()
+        {
+            worker_ = ::getpid();
+
+            if (recording_)
+            {
+                lsfutil::LsfDataSource::defaultSource(recording_);
+            }
+
+            cache_.start();
+            startPrerender();
+        }
+
+
+        //- The pre-forking master records for its workers once per
+        //  refresh interval. A failed recording leaves the last one
+        virtual void process_wait()
+        {
+            if (recording_ && time(0) >= recorded_ + cache_.interval())
+            {
+                recorded_ = time(0);
+                lsfutil::LsfReplaySource::record
+                (
+                    recording_->dir(),
+                    lsfutil::LsfDataSource::defaultSource()
+                );
+            }
+            else
+            {
+                ::sleep(1);
+            }
+        }
+
+
         //- Extra content for about
         virtual void content_about
         (
@@ -429,6 +997,43 @@ public:
             printenv(os, "LSF_SERVERDIR");
 
             os  << "</pre></blockquote>\n";
+
+            os  << "<p>LSF data source: "
+                << lsfutil::LsfDataSource::defaultSource().name()
+                << "<br />\n"
+                << "LSF refresh interval: " << cache_.interval()
+                << "s<br />\n"
+                << "LSF max staleness: " << cache_.maxStale()
+                << "s<br />\n"
+                << "LSF requests coalesced: " << cache_.coalesced()
+                << "<br />\n"
+                << "LSF failed updates: " << cache_.failures()
+                << "</p>\n";
+        }
+
+
+        //- Extra content for server-info
+        virtual void content_info
+        (
+            std::ostream& os,
+            const HeaderType& head
+        ) const
+        {
+            const char* br = "<br />\n";
+
+            unsigned long prerendered;
+            {
+                markutil::Mutex::Lock lock(prerenderMutex_);
+                prerendered = prerendered_;
+            }
+
+            os  << "<hr /><h3>Response Cache</h3><blockquote>"
+                << "Hits: "   << responses_.hits() << br
+                << "Misses: " << responses_.misses() << br
+                << "Bytes: "  << responses_.bytes()
+                << " of " << responses_.maxBytes() << br
+                << "Pre-rendered: " << prerendered << br
+                << "</blockquote>\n";
         }
 
 
@@ -480,7 +1085,84 @@ public:
 
 int main(int argc, char **argv)
 {
-    const std::string name("sample-server");
+    const std::string name("lsf-server");
+
+    unsigned refresh = lsfutil::LsfSnapshotCache::defaultInterval;
+    unsigned maxStale = lsfutil::LsfSnapshotCache::defaultMaxStale;
+    std::string replayDir;
+    markutil::HttpServer::RunType runType = markutil::HttpServer::FORKING;
+    unsigned threads = markutil::HttpServer::defaultThreads;
+    unsigned processes = markutil::HttpServer::defaultProcesses;
+
+    // leading options
+    int argI = 1;
+    for (; argI < argc && argv[argI][0] == '-'; ++argI)
+    {
+        const std::string opt(argv[argI]);
+
+        if (opt == "-refresh" && argI+1 < argc)
+        {
+            refresh = atoi(argv[++argI]);
+        }
+        else if (opt == "-max-stale" && argI+1 < argc)
+        {
+            maxStale = atoi(argv[++argI]);
+        }
+        else if (opt == "-run" && argI+1 < argc)
+        {
+            const std::string how(argv[++argI]);
+
+            if (how == "fork")
+            {
+                runType = markutil::HttpServer::FORKING;
+            }
+            else if (how == "select")
+            {
+                runType = markutil::HttpServer::SELECT;
+            }
+            else if (how == "epoll")
+            {
+                runType = markutil::HttpServer::EPOLL;
+            }
+            else if (how == "threads")
+            {
+                runType = markutil::HttpServer::THREADPOOL;
+            }
+            else if (how == "prefork")
+            {
+                runType = markutil::HttpServer::PREFORK;
+            }
+            else
+            {
+                std::cerr
+                    << "unknown run type: " << how << "\n\n";
+                argI = argc;   // force usage
+                break;
+            }
+        }
+        else if (opt == "-threads" && argI+1 < argc)
+        {
+            threads = atoi(argv[++argI]);
+        }
+        else if (opt == "-processes" && argI+1 < argc)
+        {
+            processes = atoi(argv[++argI]);
+        }
+        else if (opt == "-replay" && argI+1 < argc)
+        {
+            replayDir = argv[++argI];
+        }
+        else
+        {
+            std::cerr
+                << "unknown option: " << opt << "\n\n";
+            argI = argc;   // force usage
+            break;
+        }
+    }
+
+    argc -= argI - 1;
+    argv += argI - 1;
 
     if (argc < 3 || argc > 4)
     {
@@ -488,8 +1170,26 @@ int main(int argc, char **argv)
             << "incorrect number of arguments\n\n";
 
         std::cerr
-            << "usage: "<< name << " Port DocRoot [cgi-bin]\n\n"
+            << "usage: "<< name
+            << " [-refresh Sec] [-max-stale Sec] [-replay Dir]\n"
+            << "       [-run Type] [-threads N] [-processes N]"
+            << " Port DocRoot [cgi-bin]\n\n"
             << "Serve LSF information as text or xml, as well as providing a basic web server.\n\n"
+            << "options:\n"
+            << "  -refresh Sec   LSF refresh interval (default "
+            << lsfutil::LsfSnapshotCache::defaultInterval << ")\n"
+            << "  -max-stale Sec max age of LSF information served when LSF\n"
+            << "                 is unavailable, 0 for any (default "
+            << lsfutil::LsfSnapshotCache::defaultMaxStale << ")\n"
+            << "  -replay Dir    replay LSF information recorded in Dir\n"
+            << "                 (see lsf-direct -record) instead of using LSF\n"
+            << "  -run Type      server type: fork (default), select, epoll,\n"
+            << "                 threads, prefork. The prefork workers replay\n"
+            << "                 what the master records to /tmp/lsf-server.*\n"
+            << "  -threads N     number of worker threads (default "
+            << markutil::HttpServer::defaultThreads << ")\n"
+            << "  -processes N   number of pre-forked worker processes (default "
+            << markutil::HttpServer::defaultProcesses << ")\n\n"
             << "Eg,\n"
             << name << " " << markutil::HttpServer::defaultPort
             << " " << markutil::HttpServer::defaultRoot << "\n\n";
@@ -525,14 +1225,80 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // verify replay directory, which must be absolute after daemonizing
+    if (replayDir.size())
+    {
+        char* resolved = ::realpath(replayDir.c_str(), NULL);
+
+        if (!resolved || !markutil::HttpCore::isDir(resolved))
+        {
+            std::cerr
+                << "Directory does not exist: " << replayDir << "\n";
+            return 1;
+        }
+
+        replayDir = resolved;
+        ::free(resolved);
+    }
+
+    lsfutil::LsfReplaySource replay(replayDir);
+    if (replayDir.size())
+    {
+        lsfutil::LsfDataSource::defaultSource(&replay);
+    }
+
+    // the pre-forking master queries LSF for all of its workers
+    std::string recordDir;
+    if (runType == markutil::HttpServer::PREFORK && replayDir.empty())
+    {
+        char tmpl[] = "/tmp/lsf-server.XXXXXX";
+        if (!::mkdtemp(tmpl))
+        {
+            std::cerr
+                << "Cannot create a recording directory in /tmp\n";
+            return 1;
+        }
+
+        recordDir = tmpl;
+    }
+
+    lsfutil::LsfReplaySource recording(recordDir);
+
     markutil::HttpServer::daemonize();
 
-    LsfServer server(port, docRoot);
+    // the refresher thread must be started after daemonizing.
+    // Forked processes serve the snapshot current when they were forked,
+    // pre-forked ones start their own
+    lsfutil::LsfSnapshotCache cache(refresh);
+    cache.maxStale(maxStale);
+
+    LsfServer server(port, docRoot, cache);
     server.cgibin(cgiBin);
+    server.threads(threads);
+    server.processes(processes);
+
+    if (runType == markutil::HttpServer::PREFORK)
+    {
+        if (recordDir.size())
+        {
+            server.recordFor(recording);
+        }
+    }
+    else
+    {
+        cache.start();
+
+        // forked children would neither see the bodies pre-rendered
+        // after the fork nor be safe from inheriting a locked cache
+        if (runType != markutil::HttpServer::FORKING)
+        {
+            server.startPrerender();
+        }
+    }
 
     server.listen(64);
 
-    return server.run();
+    return server.run(runType);
 }
 
 
@@ -0,0 +1,125 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfArena.hpp"
+
+#include <cstring>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+size_t lsfutil::LsfArena::defaultChunkSize = 256*1024;
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+char* lsfutil::LsfArena::newChunk(size_t bytes)
+{
+    chunks_.reserve(chunks_.size() + 1);
+
+    char* chunk = new char[bytes];
+    chunks_.push_back(chunk);
+    capacity_ += bytes;
+
+    return chunk;
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfArena::LsfArena(size_t chunkSize)
+:
+    chunks_(),
+    next_(NULL),
+    avail_(0),
+    chunkSize_(chunkSize < 64 ? 64 : chunkSize),
+    size_(0),
+    capacity_(0)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfArena::~LsfArena()
+{
+    clear();
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+void* lsfutil::LsfArena::allocate(size_t bytes, size_t align)
+{
+    // padding to align the next free byte
+    size_t pad = (align - reinterpret_cast<size_t>(next_) % align) % align;
+
+    if (pad + bytes > avail_)
+    {
+        if (bytes > chunkSize_/4)
+        {
+            // a chunk of its own, leaving the current chunk in use
+            size_ += bytes;
+            return newChunk(bytes);
+        }
+
+        // the remainder of the current chunk is abandoned
+        next_  = newChunk(chunkSize_);
+        avail_ = chunkSize_;
+        pad    = 0;
+    }
+
+    char* ptr = next_ + pad;
+
+    next_  += pad + bytes;
+    avail_ -= pad + bytes;
+    size_  += bytes;
+
+    return ptr;
+}
+
+
+const char* lsfutil::LsfArena::copy(const char* str, size_t len)
+{
+    char* ptr = static_cast<char*>(allocate(len + 1, 1));
+
+    memcpy(ptr, str, len);
+    ptr[len] = '\0';
+
+    return ptr;
+}
+
+
+void lsfutil::LsfArena::clear()
+{
+    for (unsigned i = 0; i < chunks_.size(); ++i)
+    {
+        delete[] chunks_[i];
+    }
+
+    chunks_.clear();
+    next_     = NULL;
+    avail_    = 0;
+    size_     = 0;
+    capacity_ = 0;
+}
+
+
+/* ************************************************************************* */
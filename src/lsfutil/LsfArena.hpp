@@ -0,0 +1,177 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfArena
+
+Description
+    A bump allocator: memory is handed out sequentially from large
+    chunks and is only released all at once, by clear() or on destruction.
+
+    Holds the text and the arrays of a job snapshot, which are written
+    once when the snapshot is taken and then only read until the snapshot
+    is dropped.
+    This replaces many small heap allocations (and their frees) with a
+    few large ones, which keeps the heap of a long-running server from
+    fragmenting and the threads from contending on the allocator.
+
+    Not thread-safe: the snapshot is filled by a single thread.
+
+SourceFiles
+    LsfArena.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_ARENA_H
+#define LSF_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+#include "lsfutil/LsfSpan.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                          Class LsfArena Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfArena
+{
+    // Private data
+
+        //- The chunks allocated
+        std::vector<char*> chunks_;
+
+        //- The next free byte of the current chunk
+        char* next_;
+
+        //- The bytes remaining in the current chunk
+        size_t avail_;
+
+        //- The size of a regular chunk
+        size_t chunkSize_;
+
+        //- The bytes handed out
+        size_t size_;
+
+        //- The bytes allocated for all chunks
+        size_t capacity_;
+
+
+    // Private Member Functions
+
+        //- Allocate a new chunk and add it to the chunks
+        char* newChunk(size_t);
+
+        //- Disallow default bitwise copy construct
+        LsfArena(const LsfArena&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const LsfArena&);
+
+
+public:
+
+    // Static data members
+
+        //- The default size of a chunk (bytes)
+        static size_t defaultChunkSize;
+
+
+    // Constructors
+
+        //- Construct empty, with the given chunk size
+        explicit LsfArena(size_t chunkSize = defaultChunkSize);
+
+
+    //- Destructor, releases all memory
+    ~LsfArena();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The bytes handed out
+            size_t size() const
+            {
+                return size_;
+            }
+
+            //- The bytes allocated for all chunks
+            size_t capacity() const
+            {
+                return capacity_;
+            }
+
+
+        // Edit
+
+            //- Allocate the given number of bytes with the given alignment,
+            //  which must be a power of two.
+            //  Requests larger than a quarter chunk get a chunk of their own
+            void* allocate(size_t, size_t align = sizeof(double));
+
+            //- A nul-terminated copy of the given characters
+            const char* copy(const char*, size_t);
+
+            //- An uninitialised array of items of plain data
+            template<class T>
+            T* array(size_t n)
+            {
+                return static_cast<T*>(allocate(n*sizeof(T)));
+            }
+
+            //- A copy of the given items of plain data
+            template<class T>
+            LsfSpan<T> copy(const std::vector<T>& list)
+            {
+                if (list.empty())
+                {
+                    return LsfSpan<T>();
+                }
+
+                T* items = array<T>(list.size());
+                for (unsigned i = 0; i < list.size(); ++i)
+                {
+                    items[i] = list[i];
+                }
+
+                return LsfSpan<T>(items, list.size());
+            }
+
+            //- Release all memory
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_ARENA_H
+
+// ************************************************************************* //
@@ -0,0 +1,215 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfBatchSource.hpp"
+
+#ifndef WITHOUT_LSF
+#include <lsf/lsbatch.h>
+#endif
+
+
+// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+
+bool lsfutil::LsfBatchSource::init()
+{
+#ifdef WITHOUT_LSF
+    return false;
+#else
+    return lsb_init("lsfutil::LsfBatchSource") >= 0;
+#endif
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfBatchSource::LsfBatchSource()
+:
+    LsfDataSource()
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfBatchSource::~LsfBatchSource()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+std::string lsfutil::LsfBatchSource::name() const
+{
+    return "libbat";
+}
+
+
+bool lsfutil::LsfBatchSource::fetchJobs
+(
+    std::vector<LsfJobEntry>& list,
+    LsfStringPool& pool,
+    bool withPending
+)
+{
+    if (!init())
+    {
+        return false;
+    }
+
+#ifndef WITHOUT_LSF
+    int options = CUR_JOB;
+    if (withPending)
+    {
+        options |= PEND_JOB;   // include pending jobs
+    }
+
+    // gets the total number of jobs, -1 on failure
+    int nJobs = lsb_openjobinfo(0, NULL, "all", NULL, NULL, options);
+
+    if (nJobs < 0)
+    {
+        return false;
+    }
+
+    list.reserve(list.size() + nJobs);
+    while (nJobs > 0)
+    {
+        const struct jobInfoEnt *job = lsb_readjobinfo(&nJobs);
+        if (job)
+        {
+            list.push_back(LsfJobEntry(*job, pool));
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // close the connection
+    lsb_closejobinfo();
+#endif
+
+    return true;
+}
+
+
+bool lsfutil::LsfBatchSource::fetchHosts(std::vector<LsfHostEntry>& list)
+{
+    if (!init())
+    {
+        return false;
+    }
+
+#ifndef WITHOUT_LSF
+    int numHosts = 0;   // get all hosts
+
+    // gets the total number of hosts, return NULL on failure
+    struct hostInfoEnt *hostArray = lsb_hostinfo(NULL, &numHosts);
+
+    if (!hostArray || numHosts < 0)
+    {
+        return false;
+    }
+
+    list.reserve(list.size() + numHosts);
+    for (int hostI = 0; hostI < numHosts; ++hostI)
+    {
+        list.push_back(LsfHostEntry(hostArray[hostI]));
+    }
+#endif
+
+    return true;
+}
+
+
+bool lsfutil::LsfBatchSource::fetchQueues(std::vector<LsfQueueEntry>& list)
+{
+    if (!init())
+    {
+        return false;
+    }
+
+#ifndef WITHOUT_LSF
+    int numQueues = 0;   // get all queues
+
+    // gets the total number of queues, return NULL on failure
+    struct queueInfoEnt *queueArray = lsb_queueinfo
+    (
+        NULL,
+        &numQueues,
+        NULL,
+        NULL,
+        0
+    );
+
+    if (!queueArray || numQueues < 0)
+    {
+        return false;
+    }
+
+    list.reserve(list.size() + numQueues);
+    for (int queueI = 0; queueI < numQueues; ++queueI)
+    {
+        list.push_back(LsfQueueEntry(queueArray[queueI]));
+    }
+#endif
+
+    return true;
+}
+
+
+bool lsfutil::LsfBatchSource::fetchHostGroups
+(
+    std::vector<LsfHostGroupEntry>& list
+)
+{
+    if (!init())
+    {
+        return false;
+    }
+
+#ifndef WITHOUT_LSF
+    int numGroups = 0;   // get all host groups
+
+    // gets the total number of host groups, return NULL on failure,
+    // but also when there are none
+    struct groupInfoEnt *groupArray = lsb_hostgrpinfo
+    (
+        NULL,
+        &numGroups,
+        GRP_ALL | GRP_RECURSIVE
+    );
+
+    if (!groupArray)
+    {
+        return lsberrno == LSBE_NO_ERROR || lsberrno == LSBE_NO_HOST_GROUP;
+    }
+
+    list.reserve(list.size() + numGroups);
+    for (int groupI = 0; groupI < numGroups; ++groupI)
+    {
+        list.push_back(LsfHostGroupEntry(groupArray[groupI]));
+    }
+#endif
+
+    return true;
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,103 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfBatchSource
+
+Description
+    Obtain job, host and queue information directly from the LSF
+    batch library (libbat).
+
+    When compiled with WITHOUT_LSF, every fetch fails.
+
+SourceFiles
+    LsfBatchSource.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_BATCH_SOURCE_H
+#define LSF_BATCH_SOURCE_H
+
+#include "lsfutil/LsfDataSource.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class LsfBatchSource Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfBatchSource
+:
+    public LsfDataSource
+{
+    // Private Member Functions
+
+        //- Initialize the batch library, false on failure
+        static bool init();
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        LsfBatchSource();
+
+
+    //- Destructor
+    virtual ~LsfBatchSource();
+
+
+    // Member Functions
+
+        //- Short description of the source
+        virtual std::string name() const;
+
+        //- Append the current (running and optionally pending) jobs
+        virtual bool fetchJobs
+        (
+            std::vector<LsfJobEntry>&,
+            LsfStringPool&,
+            bool withPending
+        );
+
+        //- Append the current hosts
+        virtual bool fetchHosts(std::vector<LsfHostEntry>&);
+
+        //- Append the current queues
+        virtual bool fetchQueues(std::vector<LsfQueueEntry>&);
+
+        //- Append the current host groups, recursively expanded
+        virtual bool fetchHostGroups(std::vector<LsfHostGroupEntry>&);
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_BATCH_SOURCE_H
+
+// ************************************************************************* //
@@ -20,6 +20,7 @@ License
 \*---------------------------------------------------------------------------*/
 
 #include "lsfutil/LsfCore.hpp"
+#include "lsfutil/LsfRusage.hpp"
 #include <sstream>
 
 
@@ -93,38 +94,16 @@ lsfutil::LsfCore::parseRusage(const std::string& resReq)
 {
     std::map<std::string, std::string> output;
 
-    const std::string begMark = "rusage[";
-    std::string::size_type beg = resReq.find(begMark);
-    if (beg != std::string::npos)
+    LsfStringPool pool;
+    const LsfRusage rusage(resReq, pool);
+    for
+    (
+        LsfRusage::const_iterator iter = rusage.begin();
+        iter != rusage.end() && !iter->alternative;
+        ++iter
+    )
     {
-        beg += begMark.size();
-        std::string::size_type end;
-        std::string::size_type equals;
-
-        while
-        (
-            (end = resReq.find_first_of(",:]", beg)) != std::string::npos
-         && (equals = resReq.find('=', beg)) != std::string::npos
-         && (equals < end)
-        )
-        {
-            std::string key = resReq.substr(beg, equals-beg);
-            ++equals;
-            std::string val = resReq.substr(equals, end-equals);
-            output[key] = val;
-
-            if (resReq[end] == ':')
-            {
-                end = resReq.find_first_of(",]", end);
-            }
-
-            if (end == std::string::npos || resReq[end] == ']')
-            {
-                break;
-            }
-
-            beg = end + 1;
-        }
+        output[pool[iter->name].str()] = pool[iter->value].str();
     }
 
     return output;
@@ -150,6 +129,53 @@ lsfutil::LsfCore::parseSpaceDelimited(const std::string& str)
 }
 
 
+std::string lsfutil::LsfCore::escape(const std::string& str)
+{
+    std::string output;
+    output.reserve(str.size());
+
+    for (std::string::size_type i = 0; i < str.size(); ++i)
+    {
+        if (str[i] == '\\')
+        {
+            output += "\\\\";
+        }
+        else if (str[i] == '\n')
+        {
+            output += "\\n";
+        }
+        else
+        {
+            output += str[i];
+        }
+    }
+
+    return output;
+}
+
+
+std::string lsfutil::LsfCore::unescape(const std::string& str)
+{
+    std::string output;
+    output.reserve(str.size());
+
+    for (std::string::size_type i = 0; i < str.size(); ++i)
+    {
+        if (str[i] == '\\' && i + 1 < str.size())
+        {
+            ++i;
+            output += (str[i] == 'n' ? '\n' : str[i]);
+        }
+        else
+        {
+            output += str[i];
+        }
+    }
+
+    return output;
+}
+
+
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
 lsfutil::LsfCore::LsfCore()
@@ -99,12 +99,21 @@ public:
             //  \verbatim
             //  rusage[starcdLic=1:duration=5,starccmpLic=5:duration=5,starcdJob=6]
             //  \endverbatim
+            //  Only the preferred alternative is returned.
+            //  The job entries hold their parsed lsfutil::LsfRusage.
             static rusage_map parseRusage(const std::string& resReq);
 
             //- Parse space-delimited string into a vector of strings
             static std::vector<std::string>
             parseSpaceDelimited(const std::string&);
 
+            //- Escape backslashes and newlines with a backslash,
+            //  which keeps a value on a single line
+            static std::string escape(const std::string&);
+
+            //- Undo escape()
+            static std::string unescape(const std::string&);
+
 };
 
 
@@ -0,0 +1,64 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfDataSource.hpp"
+#include "lsfutil/LsfBatchSource.hpp"
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+lsfutil::LsfDataSource* lsfutil::LsfDataSource::defaultSource_ = NULL;
+
+
+// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+
+lsfutil::LsfDataSource& lsfutil::LsfDataSource::defaultSource()
+{
+    static LsfBatchSource batchSource;
+
+    if (defaultSource_)
+    {
+        return *defaultSource_;
+    }
+
+    return batchSource;
+}
+
+
+void lsfutil::LsfDataSource::defaultSource(LsfDataSource* src)
+{
+    defaultSource_ = src;
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfDataSource::LsfDataSource()
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfDataSource::~LsfDataSource()
+{}
+
+
+/* ************************************************************************* */
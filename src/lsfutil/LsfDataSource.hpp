@@ -0,0 +1,124 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfDataSource
+
+Description
+    Abstract source of job, host, host group and queue information.
+
+    The lsfutil::LsfJobList and lsfutil::LsfHostList obtain their contents
+    from a data source: normally the LSF batch library
+    (lsfutil::LsfBatchSource), but recorded information can be replayed
+    instead (lsfutil::LsfReplaySource).
+
+SourceFiles
+    LsfDataSource.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_DATA_SOURCE_H
+#define LSF_DATA_SOURCE_H
+
+#include <string>
+#include <vector>
+
+#include "lsfutil/LsfJobEntry.hpp"
+#include "lsfutil/LsfHostEntry.hpp"
+#include "lsfutil/LsfHostGroupEntry.hpp"
+#include "lsfutil/LsfQueueEntry.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class LsfDataSource Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfDataSource
+{
+    // Private data
+
+        //- The data source used by default
+        static LsfDataSource* defaultSource_;
+
+
+public:
+
+    // Static Member Functions
+
+        //- The data source used by default (the LSF batch library)
+        static LsfDataSource& defaultSource();
+
+        //- Change the data source used by default, NULL to reset.
+        //  The caller retains ownership.
+        static void defaultSource(LsfDataSource*);
+
+
+    // Constructors
+
+        //- Construct null
+        LsfDataSource();
+
+
+    //- Destructor
+    virtual ~LsfDataSource();
+
+
+    // Member Functions
+
+        //- Short description of the source
+        virtual std::string name() const = 0;
+
+        //- Append the current (running and optionally pending) jobs,
+        //  interning their strings into the given pool
+        //  \return false on error
+        virtual bool fetchJobs
+        (
+            std::vector<LsfJobEntry>&,
+            LsfStringPool&,
+            bool withPending
+        ) = 0;
+
+        //- Append the current hosts
+        //  \return false on error
+        virtual bool fetchHosts(std::vector<LsfHostEntry>&) = 0;
+
+        //- Append the current queues
+        //  \return false on error
+        virtual bool fetchQueues(std::vector<LsfQueueEntry>&) = 0;
+
+        //- Append the current host groups
+        //  \return false on error
+        virtual bool fetchHostGroups(std::vector<LsfHostGroupEntry>&) = 0;
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_DATA_SOURCE_H
+
+// ************************************************************************* //
@@ -21,10 +21,26 @@ License
 
 #include "lsfutil/LsfHostEntry.hpp"
 
+#ifndef WITHOUT_LSF
 #include <lsf/lsbatch.h>
+#endif
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
+lsfutil::LsfHostEntry::LsfHostEntry()
+:
+    name(),
+    load_15m(0),
+    free_tmp(0),
+    free_swp(0),
+    free_mem(0),
+    maxJobs(0),
+    numJobs(0),
+    numRUN(0)
+{}
+
+
+#ifndef WITHOUT_LSF
 lsfutil::LsfHostEntry::LsfHostEntry(const struct hostInfoEnt& host)
 :
     name(host.host),
@@ -42,6 +58,7 @@ lsfutil::LsfHostEntry::LsfHostEntry(const struct hostInfoEnt& host)
     if (host.nIdx > SWP)  { free_swp = host.load[SWP]; }
     if (host.nIdx > MEM)  { free_mem = host.load[MEM]; }
 }
+#endif
 
 
 // * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
@@ -63,11 +80,6 @@ std::ostream& lsfutil::LsfHostEntry::dump(std::ostream& os) const
     os  << "numJobs: " << numJobs << "\n";
     os  << "numRUN: " << numRUN << "\n";
 
-    for (unsigned queueI = 0; queueI < queues.size(); ++queueI)
-    {
-        os  << "    queue: " << queues[queueI] << "\n";
-    }
-
     return os;
 }
 
@@ -94,12 +94,16 @@ public:
         //- The number of job slots running
         int numRUN;
 
-        //- The names of the associated queues
-        std::vector<std::string> queues;
+        //- The associated queues, as indices into the queue names of
+        //  the host list
+        std::vector<unsigned> queues;
 
 
     // Constructors
 
+        //! Construct null
+        LsfHostEntry();
+
         //! Construct from hostInfoEnt
         LsfHostEntry(const hostInfoEnt&);
 
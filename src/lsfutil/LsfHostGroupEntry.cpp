@@ -0,0 +1,63 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfHostGroupEntry.hpp"
+
+#ifndef WITHOUT_LSF
+#include <lsf/lsbatch.h>
+#endif
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfHostGroupEntry::LsfHostGroupEntry()
+:
+    name(),
+    memberList()
+{}
+
+
+#ifndef WITHOUT_LSF
+lsfutil::LsfHostGroupEntry::LsfHostGroupEntry(const struct groupInfoEnt& group)
+:
+    name(makeString(group.group)),
+    memberList(makeString(group.memberList))
+{}
+#endif
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfHostGroupEntry::~LsfHostGroupEntry()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+std::ostream& lsfutil::LsfHostGroupEntry::dump(std::ostream& os) const
+{
+    os  << "hostgroup: " << name << "\n";
+    os  << "memberList: " << memberList << "\n";
+
+    return os;
+}
+
+
+/* ************************************************************************* */
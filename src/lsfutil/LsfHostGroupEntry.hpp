@@ -0,0 +1,95 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfHostGroupEntry
+
+Description
+    Encapsulation of the parts of the LSF \c groupInfoEnt structure
+    that we use for host groups.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_HOST_GROUP_ENTRY_H
+#define LSF_HOST_GROUP_ENTRY_H
+
+#include <string>
+#include <iostream>
+
+#include "lsfutil/LsfCore.hpp"
+
+// Forward declaration of classes
+struct groupInfoEnt;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                    Class LsfHostGroupEntry Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfHostGroupEntry
+:
+    public LsfCore
+{
+public:
+
+    // Public data
+
+        //- The host group name
+        std::string name;
+
+        //- The space-delimited list of hosts and host groups in the group
+        std::string memberList;
+
+
+    // Constructors
+
+        //! Construct null
+        LsfHostGroupEntry();
+
+        //! Construct from groupInfoEnt
+        LsfHostGroupEntry(const groupInfoEnt&);
+
+
+    //! Destructor
+    ~LsfHostGroupEntry();
+
+
+    // Member Functions
+
+        // Write
+
+            //- Raw dump of information in text format
+            std::ostream& dump(std::ostream&) const;
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_HOST_GROUP_ENTRY_H
+
+// ************************************************************************* //
@@ -0,0 +1,201 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfHostJobIndex.hpp"
+
+#include <algorithm>
+#include <string>
+#include <tr1/unordered_map>
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfHostJobIndex::LsfHostJobIndex()
+:
+    slots_(),
+    slotStart_(),
+    queueSlots_(),
+    queueStart_()
+{}
+
+
+lsfutil::LsfHostJobIndex::LsfHostJobIndex
+(
+    const LsfHostList& hosts,
+    const LsfJobList& jobs,
+    LsfArena& arena
+)
+:
+    slots_(),
+    slotStart_(),
+    queueSlots_(),
+    queueStart_()
+{
+    build(hosts, jobs, arena);
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+void lsfutil::LsfHostJobIndex::build
+(
+    const LsfHostList& hosts,
+    const LsfJobList& jobs,
+    LsfArena& arena
+)
+{
+    clear();
+
+    const unsigned nHosts = hosts.size();
+    const LsfStringPool& strings = jobs.strings();
+
+    // the execHosts and queues of the jobs are string pool ids,
+    // each resolved once to a host or queue index
+    const unsigned unresolved = ~0u;
+    std::vector<unsigned> hostOf(strings.size(), unresolved);
+    std::vector<unsigned> queueOf(strings.size(), unresolved);
+
+    typedef std::tr1::unordered_map<std::string, unsigned> QueueMap;
+    QueueMap queueIndex;
+
+    const std::vector<std::string>& queueNames = hosts.queueNames();
+    for (unsigned queueI = 0; queueI < queueNames.size(); ++queueI)
+    {
+        queueIndex.insert(QueueMap::value_type(queueNames[queueI], queueI));
+    }
+
+    unsigned* slotStart = arena.array<unsigned>(nHosts + 1);
+    unsigned* queueStart = arena.array<unsigned>(nHosts + 1);
+
+    std::fill(slotStart, slotStart + nHosts + 1, 0u);
+
+    queueStart[0] = 0;
+    for (unsigned hostI = 0; hostI < nHosts; ++hostI)
+    {
+        queueStart[hostI + 1] =
+            queueStart[hostI] + hosts[hostI].queues.size();
+    }
+
+    const unsigned nQueueSlots = queueStart[nHosts];
+    unsigned* queueSlots = arena.array<unsigned>(nQueueSlots);
+
+    std::fill(queueSlots, queueSlots + nQueueSlots, 0u);
+
+
+    // count the slot runs per host
+    for (unsigned jobI = 0; jobI < jobs.size(); ++jobI)
+    {
+        const LsfSpan<LsfJobEntry::ExecHost>& execHosts =
+            jobs[jobI].execHosts;
+
+        for (unsigned runI = 0; runI < execHosts.size(); ++runI)
+        {
+            unsigned& hostI = hostOf[execHosts[runI].host];
+            if (hostI == unresolved)
+            {
+                hostI = hosts.find(strings[execHosts[runI].host].str());
+            }
+
+            if (hostI < nHosts)
+            {
+                ++slotStart[hostI + 1];
+            }
+        }
+    }
+
+    for (unsigned hostI = 0; hostI < nHosts; ++hostI)
+    {
+        slotStart[hostI + 1] += slotStart[hostI];
+    }
+
+
+    // fill the slot runs of each host in job order
+    Slots* slots = arena.array<Slots>(slotStart[nHosts]);
+    std::vector<unsigned> fill(slotStart, slotStart + nHosts);
+
+    for (unsigned jobI = 0; jobI < jobs.size(); ++jobI)
+    {
+        const LsfJobEntry& job = jobs[jobI];
+        if (job.execHosts.empty())
+        {
+            continue;
+        }
+
+        unsigned& jobQueue = queueOf[job.submit.queue];
+        if (jobQueue == unresolved)
+        {
+            QueueMap::const_iterator qIter =
+                queueIndex.find(strings[job.submit.queue].str());
+
+            jobQueue =
+            (
+                qIter == queueIndex.end() ? queueNames.size() : qIter->second
+            );
+        }
+
+        unsigned nextSlot = 0;
+        for (unsigned runI = 0; runI < job.execHosts.size(); ++runI)
+        {
+            const LsfJobEntry::ExecHost& run = job.execHosts[runI];
+            const unsigned hostI = hostOf[run.host];
+
+            const unsigned first = nextSlot;
+            nextSlot += run.slots;
+
+            if (hostI >= nHosts)
+            {
+                continue;
+            }
+
+            Slots& s = slots[fill[hostI]++];
+            s.job   = jobI;
+            s.first = first;
+            s.count = run.slots;
+
+            // the queues of a host are few
+            const std::vector<unsigned>& queues = hosts[hostI].queues;
+            for (unsigned queueI = 0; queueI < queues.size(); ++queueI)
+            {
+                if (queues[queueI] == jobQueue)
+                {
+                    queueSlots[queueStart[hostI] + queueI] += run.slots;
+                }
+            }
+        }
+    }
+
+    slots_      = LsfSpan<Slots>(slots, slotStart[nHosts]);
+    slotStart_  = LsfSpan<unsigned>(slotStart, nHosts + 1);
+    queueSlots_ = LsfSpan<unsigned>(queueSlots, nQueueSlots);
+    queueStart_ = LsfSpan<unsigned>(queueStart, nHosts + 1);
+}
+
+
+void lsfutil::LsfHostJobIndex::clear()
+{
+    slots_      = LsfSpan<Slots>();
+    slotStart_  = LsfSpan<unsigned>();
+    queueSlots_ = LsfSpan<unsigned>();
+    queueStart_ = LsfSpan<unsigned>();
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,167 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfHostJobIndex
+
+Description
+    The job slots on each host, inverted from the execHosts of the jobs.
+
+    For each host of an lsfutil::LsfHostList, the slots of the jobs in an
+    lsfutil::LsfJobList that execute on it are listed in job order as runs
+    of consecutive slots, and the number of slots used is counted for each
+    queue of the host. A wide parallel job thus has a single entry per
+    host rather than one per slot.
+    Built once per snapshot, this replaces a scan of all the jobs for
+    every host.
+
+    Host names are assumed to be unique. Slots on hosts that are not in
+    the host list are ignored.
+
+    The arrays are allocated from the arena of the snapshot, which must
+    outlive the index.
+
+SourceFiles
+    LsfHostJobIndex.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_HOST_JOB_INDEX_H
+#define LSF_HOST_JOB_INDEX_H
+
+#include <vector>
+
+#include "lsfutil/LsfArena.hpp"
+#include "lsfutil/LsfJobList.hpp"
+#include "lsfutil/LsfHostList.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class LsfHostJobIndex Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfHostJobIndex
+{
+public:
+
+    //- A run of consecutive job slots on a host
+    struct Slots
+    {
+        //- The index of the job in the job list
+        unsigned job;
+
+        //- The index of the first slot among all slots of the job,
+        //  0 for the master
+        unsigned first;
+
+        //- The number of slots
+        unsigned count;
+    };
+
+    typedef LsfSpan<Slots>::const_iterator const_iterator;
+
+
+private:
+
+    // Private data
+
+        //- The slot runs of all hosts, in host order and then job order
+        LsfSpan<Slots> slots_;
+
+        //- The start of the slot runs of each host, plus the end
+        LsfSpan<unsigned> slotStart_;
+
+        //- The slots used per queue of all hosts, in host order
+        LsfSpan<unsigned> queueSlots_;
+
+        //- The start of the queues of each host, plus the end
+        LsfSpan<unsigned> queueStart_;
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        LsfHostJobIndex();
+
+        //- Construct for the given hosts and jobs, in the arena
+        LsfHostJobIndex(const LsfHostList&, const LsfJobList&, LsfArena&);
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of hosts
+            unsigned size() const
+            {
+                return slotStart_.empty() ? 0 : slotStart_.size() - 1;
+            }
+
+            //- The first slot run on the given host
+            const_iterator begin(unsigned hostI) const
+            {
+                return slots_.begin() + slotStart_[hostI];
+            }
+
+            //- The end of the slot runs on the given host
+            const_iterator end(unsigned hostI) const
+            {
+                return slots_.begin() + slotStart_[hostI + 1];
+            }
+
+            //- The number of slot runs on the given host
+            unsigned runs(unsigned hostI) const
+            {
+                return slotStart_[hostI + 1] - slotStart_[hostI];
+            }
+
+            //- The slots used on the given host by the jobs of its
+            //  queueI-th queue
+            unsigned slotsUsed(unsigned hostI, unsigned queueI) const
+            {
+                return queueSlots_[queueStart_[hostI] + queueI];
+            }
+
+
+        // Edit
+
+            //- Rebuild for the given hosts and jobs, in the arena
+            void build(const LsfHostList&, const LsfJobList&, LsfArena&);
+
+            //- Clear the index, its arrays remain in the arena
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_HOST_JOB_INDEX_H
+
+// ************************************************************************* //
@@ -21,7 +21,125 @@ License
 
 #include "lsfutil/LsfHostList.hpp"
 
-#include <lsf/lsbatch.h>
+#include "lsfutil/LsfQueueEntry.hpp"
+
+
+//! \cond local scope
+
+// expands host lists with host groups into sets of hosts, expanding each
+// host group once
+class HostExpander
+{
+    typedef std::tr1::unordered_map<std::string, unsigned> GroupIndex;
+
+    enum State { UNEXPANDED, EXPANDING, EXPANDED };
+
+    const lsfutil::LsfHostList& hosts_;
+    const std::vector<lsfutil::LsfHostGroupEntry>& groups_;
+
+    GroupIndex groupIndex_;
+    std::vector<lsfutil::LsfHostSet> groupHosts_;
+    std::vector<State> state_;
+
+    const lsfutil::LsfHostSet& group(unsigned groupI)
+    {
+        // a group that includes itself has no hosts from the inclusion
+        if (state_[groupI] == UNEXPANDED)
+        {
+            state_[groupI] = EXPANDING;
+            expand(groups_[groupI].memberList, groupHosts_[groupI]);
+            state_[groupI] = EXPANDED;
+        }
+
+        return groupHosts_[groupI];
+    }
+
+
+public:
+
+    HostExpander
+    (
+        const lsfutil::LsfHostList& hosts,
+        const std::vector<lsfutil::LsfHostGroupEntry>& groups
+    )
+    :
+        hosts_(hosts),
+        groups_(groups),
+        groupIndex_(),
+        groupHosts_(groups.size(), lsfutil::LsfHostSet(hosts.size())),
+        state_(groups.size(), UNEXPANDED)
+    {
+        for (unsigned groupI = 0; groupI < groups.size(); ++groupI)
+        {
+            groupIndex_.insert
+            (
+                GroupIndex::value_type(groups[groupI].name, groupI)
+            );
+        }
+    }
+
+    // add the hosts of a space-delimited list to the set
+    void expand(const std::string& list, lsfutil::LsfHostSet& result)
+    {
+        const std::vector<std::string> items =
+            lsfutil::LsfCore::parseSpaceDelimited(list);
+
+        lsfutil::LsfHostSet excluded(hosts_.size());
+        bool exclusions = false;
+
+        for (unsigned itemI = 0; itemI < items.size(); ++itemI)
+        {
+            std::string name = items[itemI];
+
+            const bool exclude = (name[0] == '~');
+            if (exclude)
+            {
+                name.erase(0, 1);
+                exclusions = true;
+            }
+
+            // host preference "name+N", host group "name/"
+            std::string::size_type end = name.find('+');
+            if (end == std::string::npos)
+            {
+                end = name.size();
+            }
+            if (end && name[end - 1] == '/')
+            {
+                --end;
+            }
+            name.erase(end);
+
+            lsfutil::LsfHostSet& target = (exclude ? excluded : result);
+
+            if (name == "all" || name == "others")
+            {
+                target.setAll();
+                continue;
+            }
+
+            const unsigned hostI = hosts_.find(name);
+            if (hostI < hosts_.size())
+            {
+                target.set(hostI);
+                continue;
+            }
+
+            GroupIndex::const_iterator iter = groupIndex_.find(name);
+            if (iter != groupIndex_.end())
+            {
+                target |= group(iter->second);
+            }
+        }
+
+        if (exclusions)
+        {
+            result -= excluded;
+        }
+    }
+};
+
+//! \endcond
 
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
@@ -31,7 +149,26 @@ lsfutil::LsfHostList::LsfHostList(unsigned interval)
     std::vector<lsfutil::LsfHostEntry>(),
     lastUpdate_(0),
     interval_(interval),
-    error_(false)
+    error_(false),
+    source_(LsfDataSource::defaultSource()),
+    queueNames_(),
+    queueHosts_(),
+    hostIndex_()
+{
+    this->update();
+}
+
+
+lsfutil::LsfHostList::LsfHostList(LsfDataSource& source, unsigned interval)
+:
+    std::vector<lsfutil::LsfHostEntry>(),
+    lastUpdate_(0),
+    interval_(interval),
+    error_(false),
+    source_(source),
+    queueNames_(),
+    queueHosts_(),
+    hostIndex_()
 {
     this->update();
 }
@@ -57,80 +194,60 @@ bool lsfutil::LsfHostList::update()
         lastUpdate_ = now;
 
         this->clear();
+        queueNames_.clear();
+        queueHosts_.clear();
+        hostIndex_.clear();
+
+        std::vector<lsfutil::LsfHostEntry>& list = *this;
+        std::vector<lsfutil::LsfQueueEntry> queues;
+        std::vector<lsfutil::LsfHostGroupEntry> groups;
 
-        if (lsb_init("lsfutil::LsfHostList::update()") < 0)
+        error_ = !source_.fetchHosts(list);
+        if (!source_.fetchQueues(queues))
         {
             error_ = true;
         }
-        else
+        if (!source_.fetchHostGroups(groups))
         {
-            int numHosts = 0;   // get all hosts
-
-            // gets the total number of hosts, return NULL on failure
-            struct hostInfoEnt *hostArray = lsb_hostinfo(NULL, &numHosts);
+            error_ = true;
+        }
 
-            if (hostArray && numHosts >= 0)
-            {
-                this->reserve(numHosts);
-                for (int hostI = 0; hostI < numHosts; ++hostI)
-                {
-                    this->push_back(lsfutil::LsfHostEntry(hostArray[hostI]));
-                }
-            }
+        // index the hosts by name, the first of any duplicates
+        hostIndex_.rehash(list.size());
+        for (unsigned hostI = 0; hostI < list.size(); ++hostI)
+        {
+            hostIndex_.insert(HostIndex::value_type(list[hostI].name, hostI));
+        }
 
+        HostExpander expander(*this, groups);
+
+        queueNames_.reserve(queues.size());
+        queueHosts_.reserve(queues.size());
+        for
+        (
+            std::vector<lsfutil::LsfQueueEntry>::const_iterator qIter =
+                queues.begin();
+            qIter != queues.end();
+            ++qIter
+        )
+        {
+            const unsigned queueI = queueNames_.size();
+            queueNames_.push_back(qIter->name);
+            queueHosts_.push_back(LsfHostSet(list.size()));
 
-            int numQueues = 0;   // get all queues
+            LsfHostSet& qhosts = queueHosts_.back();
+            expander.expand(qIter->hostList, qhosts);
 
-            // gets the total number of queues, return NULL on failure
-            struct queueInfoEnt *queueArray = lsb_queueinfo
+            // add as appropriate
+            for
             (
-                NULL,
-                &numQueues,
-                NULL,
-                NULL,
-                0
-            );
-
-            if (queueArray && numQueues >= 0)
+                unsigned hostI = qhosts.next(0);
+                hostI < qhosts.size();
+                hostI = qhosts.next(hostI + 1)
+            )
             {
-                for (int queueI = 0; queueI < numQueues; ++queueI)
-                {
-                    const struct queueInfoEnt* queueInfo = &(queueArray[queueI]);
-
-                    std::vector<std::string> qhosts =
-                        LsfCore::parseSpaceDelimited(queueInfo->hostList);
-
-                    // add as appropriate
-                    for
-                    (
-                        unsigned qhostI = 0;
-                        qhostI < qhosts.size();
-                        ++qhostI
-                    )
-                    {
-                        const std::string& hname = qhosts[qhostI];
-
-                        for
-                        (
-                            iterator iter = this->begin();
-                            iter != this->end();
-                            ++iter
-                        )
-                        {
-                            if (iter->name == hname)
-                            {
-                                iter->queues.push_back(queueInfo->queue);
-                            }
-                        }
-                    }
-
-                    // TODO: add job information ...
-//                    std::cerr
-//                        <<"queue: " << queueInfo->queue << "\n"
-//                        <<"  hostList: " << queueInfo->hostList << "\n";
-                }
+                list[hostI].queues.push_back(queueI);
             }
-
         }
     }
 
@@ -138,6 +255,14 @@ bool lsfutil::LsfHostList::update()
 }
 
 
+unsigned lsfutil::LsfHostList::find(const std::string& name) const
+{
+    HostIndex::const_iterator iter = hostIndex_.find(name);
+
+    return (iter == hostIndex_.end() ? this->size() : iter->second);
+}
+
+
 std::ostream& lsfutil::LsfHostList::dump(std::ostream& os) const
 {
     for (unsigned hostI = 0; hostI < this->size(); ++hostI)
@@ -146,7 +271,14 @@ std::ostream& lsfutil::LsfHostList::dump(std::ostream& os) const
         {
             os  << "==================================================\n";
         }
-        this->operator[](hostI).dump(os);
+
+        const LsfHostEntry& host = this->operator[](hostI);
+        host.dump(os);
+
+        for (unsigned queueI = 0; queueI < host.queues.size(); ++queueI)
+        {
+            os  << "    queue: " << queueNames_[host.queues[queueI]] << "\n";
+        }
         os  << "==================================================\n";
     }
 
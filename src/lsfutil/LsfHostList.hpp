@@ -23,6 +23,15 @@ Class
 Description
     A list of lsfutil::LsfHostEntry elements.
 
+    The hosts are indexed by name, and refer to their queues by index
+    into the queue names of the list.
+
+    The host list of each queue is expanded into a set of hosts:
+    host groups (with or without the trailing '/' of bqueues), \c all,
+    \c others and exclusions with '~' are resolved, and host preferences
+    ('+' suffixes) are ignored. Host groups are fetched and expanded once
+    per update.
+
 \*---------------------------------------------------------------------------*/
 
 #ifndef LSF_HOST_LIST_H
@@ -31,8 +40,11 @@ Description
 #include <string>
 #include <vector>
 #include <iostream>
+#include <tr1/unordered_map>
 
 #include "lsfutil/LsfHostEntry.hpp"
+#include "lsfutil/LsfHostSet.hpp"
+#include "lsfutil/LsfDataSource.hpp"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -53,6 +65,9 @@ class LsfHostList
 {
     // Private data
 
+        //- Host index by name
+        typedef std::tr1::unordered_map<std::string, unsigned> HostIndex;
+
         //- The last update time
         time_t lastUpdate_;
 
@@ -62,6 +77,18 @@ class LsfHostList
         //- Error
         bool error_;
 
+        //- The source of the host and queue information
+        LsfDataSource& source_;
+
+        //- The names of all queues
+        std::vector<std::string> queueNames_;
+
+        //- The hosts of each queue
+        std::vector<LsfHostSet> queueHosts_;
+
+        //- The index of each host by name
+        HostIndex hostIndex_;
+
 public:
 
     // Constructors
@@ -70,6 +97,9 @@ public:
         //  In the future, allow for internal caching
         LsfHostList(unsigned interval = 10);
 
+        //- Construct from a specific data source
+        LsfHostList(LsfDataSource&, unsigned interval = 10);
+
 
     //- Destructor
     ~LsfHostList();
@@ -83,6 +113,33 @@ public:
             using std::vector<lsfutil::LsfHostEntry>::size;
             using std::vector<lsfutil::LsfHostEntry>::operator[];
 
+            //- The index of the named host, size() if there is none
+            unsigned find(const std::string& name) const;
+
+            //- The names of all queues
+            const std::vector<std::string>& queueNames() const
+            {
+                return queueNames_;
+            }
+
+            //- The name of a queue, by index
+            const std::string& queueName(unsigned queueI) const
+            {
+                return queueNames_[queueI];
+            }
+
+            //- The hosts of a queue, by index
+            const LsfHostSet& queueHosts(unsigned queueI) const
+            {
+                return queueHosts_[queueI];
+            }
+
+            //- Is the host in the queue?
+            bool inQueue(unsigned hostI, unsigned queueI) const
+            {
+                return queueHosts_[queueI].test(hostI);
+            }
+
 
         // Check
 
@@ -0,0 +1,137 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfHostSet.hpp"
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfHostSet::LsfHostSet()
+:
+    words_(),
+    size_(0)
+{}
+
+
+lsfutil::LsfHostSet::LsfHostSet(unsigned nHosts, bool all)
+:
+    words_((nHosts + wordBits - 1) / wordBits, 0UL),
+    size_(nHosts)
+{
+    if (all)
+    {
+        setAll();
+    }
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+unsigned lsfutil::LsfHostSet::count() const
+{
+    unsigned n = 0;
+    for (unsigned wordI = 0; wordI < words_.size(); ++wordI)
+    {
+        n += __builtin_popcountl(words_[wordI]);
+    }
+
+    return n;
+}
+
+
+unsigned lsfutil::LsfHostSet::next(unsigned hostI) const
+{
+    if (hostI >= size_)
+    {
+        return size_;
+    }
+
+    unsigned wordI = hostI / wordBits;
+    unsigned long word = words_[wordI] & (~0UL << (hostI % wordBits));
+
+    while (!word)
+    {
+        if (++wordI >= words_.size())
+        {
+            return size_;
+        }
+        word = words_[wordI];
+    }
+
+    return wordI*wordBits + __builtin_ctzl(word);
+}
+
+
+void lsfutil::LsfHostSet::setAll()
+{
+    if (words_.empty())
+    {
+        return;
+    }
+
+    words_.assign(words_.size(), ~0UL);
+
+    // keep the bits beyond the last host clear
+    const unsigned tail = size_ % wordBits;
+    if (tail)
+    {
+        words_.back() = (1UL << tail) - 1;
+    }
+}
+
+
+lsfutil::LsfHostSet&
+lsfutil::LsfHostSet::operator|=(const LsfHostSet& other)
+{
+    const unsigned n =
+    (
+        words_.size() < other.words_.size()
+      ? words_.size() : other.words_.size()
+    );
+
+    for (unsigned wordI = 0; wordI < n; ++wordI)
+    {
+        words_[wordI] |= other.words_[wordI];
+    }
+
+    return *this;
+}
+
+
+lsfutil::LsfHostSet&
+lsfutil::LsfHostSet::operator-=(const LsfHostSet& other)
+{
+    const unsigned n =
+    (
+        words_.size() < other.words_.size()
+      ? words_.size() : other.words_.size()
+    );
+
+    for (unsigned wordI = 0; wordI < n; ++wordI)
+    {
+        words_[wordI] &= ~other.words_[wordI];
+    }
+
+    return *this;
+}
+
+
+/* ************************************************************************* */
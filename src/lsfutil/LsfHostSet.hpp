@@ -0,0 +1,134 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfHostSet
+
+Description
+    A dense set of host indices, stored as a bitset over the hosts of an
+    lsfutil::LsfHostList.
+
+    Membership tests, insertion and removal are O(1). Unions and
+    differences of sets handle one machine word of hosts at a time.
+
+SourceFiles
+    LsfHostSet.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_HOST_SET_H
+#define LSF_HOST_SET_H
+
+#include <climits>
+#include <vector>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class LsfHostSet Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfHostSet
+{
+    // Private data
+
+        //- The number of bits per word
+        static const unsigned wordBits = CHAR_BIT*sizeof(unsigned long);
+
+        //- The bits
+        std::vector<unsigned long> words_;
+
+        //- The number of hosts
+        unsigned size_;
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        LsfHostSet();
+
+        //- Construct for the given number of hosts, with none or all
+        //  of them in the set
+        explicit LsfHostSet(unsigned nHosts, bool all = false);
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of hosts that the set is over
+            unsigned size() const
+            {
+                return size_;
+            }
+
+            //- The number of hosts in the set
+            unsigned count() const;
+
+            //- Is the host in the set?
+            bool test(unsigned hostI) const
+            {
+                return (words_[hostI / wordBits] >> (hostI % wordBits)) & 1;
+            }
+
+            //- The first host in the set from hostI onwards,
+            //  size() if there is none
+            unsigned next(unsigned hostI) const;
+
+
+        // Edit
+
+            //- Add a host to the set
+            void set(unsigned hostI)
+            {
+                words_[hostI / wordBits] |= 1UL << (hostI % wordBits);
+            }
+
+            //- Remove a host from the set
+            void reset(unsigned hostI)
+            {
+                words_[hostI / wordBits] &= ~(1UL << (hostI % wordBits));
+            }
+
+            //- Add all hosts to the set
+            void setAll();
+
+            //- Add the hosts of another set
+            LsfHostSet& operator|=(const LsfHostSet&);
+
+            //- Remove the hosts of another set
+            LsfHostSet& operator-=(const LsfHostSet&);
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_HOST_SET_H
+
+// ************************************************************************* //
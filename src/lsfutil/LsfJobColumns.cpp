@@ -0,0 +1,181 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfJobColumns.hpp"
+
+#include <algorithm>
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfJobColumns::LsfJobColumns()
+:
+    jobId_(),
+    stateBit_(),
+    user_()
+{}
+
+
+lsfutil::LsfJobColumns::LsfJobColumns
+(
+    const LsfJobList& jobs,
+    LsfArena& arena
+)
+:
+    jobId_(),
+    stateBit_(),
+    user_()
+{
+    build(jobs, arena);
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+void lsfutil::LsfJobColumns::selectAll(Mask& mask) const
+{
+    mask.assign(size(), 1);
+}
+
+
+void lsfutil::LsfJobColumns::keepStates(Mask& mask, unsigned states) const
+{
+    const unsigned n = size();
+    if (!n)
+    {
+        return;
+    }
+
+    // byte stores into the mask could alias the vector internals,
+    // so use plain pointers to let the loop be vectorized
+    unsigned char* keep = &mask[0];
+    const unsigned char* bits = stateBit_.data();
+    const unsigned char wanted = states;
+
+    for (unsigned i = 0; i < n; ++i)
+    {
+        keep[i] &= (bits[i] & wanted) != 0;
+    }
+}
+
+
+void lsfutil::LsfJobColumns::keepUsers
+(
+    Mask& mask,
+    const std::vector<unsigned char>& users
+) const
+{
+    const unsigned n = size();
+    for (unsigned i = 0; i < n; ++i)
+    {
+        mask[i] &= users[user_[i]];
+    }
+}
+
+
+void lsfutil::LsfJobColumns::keepJobIds
+(
+    Mask& mask,
+    const std::vector<int>& ids
+) const
+{
+    const unsigned n = size();
+    for (unsigned i = 0; i < n; ++i)
+    {
+        if (mask[i])
+        {
+            mask[i] = std::binary_search(ids.begin(), ids.end(), jobId_[i]);
+        }
+    }
+}
+
+
+unsigned lsfutil::LsfJobColumns::count(const Mask& mask)
+{
+    const unsigned size = mask.size();
+
+    unsigned n = 0;
+    for (unsigned i = 0; i < size; ++i)
+    {
+        n += (mask[i] != 0);
+    }
+    return n;
+}
+
+
+void lsfutil::LsfJobColumns::selected
+(
+    const Mask& mask,
+    std::vector<int>& indices
+)
+{
+    const unsigned n = count(mask);
+
+    // without branches: write every index, but only advance when selected
+    indices.resize(n + 1);
+
+    unsigned selI = 0;
+    for (unsigned i = 0; i < mask.size(); ++i)
+    {
+        indices[selI] = i;
+        selI += (mask[i] != 0);
+    }
+
+    indices.resize(n);
+}
+
+
+void lsfutil::LsfJobColumns::build
+(
+    const LsfJobList& jobs,
+    LsfArena& arena
+)
+{
+    const unsigned n = jobs.size();
+
+    int* jobId = arena.array<int>(n);
+    unsigned char* stateBit = arena.array<unsigned char>(n);
+    unsigned* user = arena.array<unsigned>(n);
+
+    for (unsigned i = 0; i < n; ++i)
+    {
+        const LsfJobEntry& job = jobs[i];
+
+        jobId[i]    = job.jobId;
+        stateBit[i] = 1u << job.statusType;
+        user[i]     = job.user;
+    }
+
+    jobId_    = LsfSpan<int>(jobId, n);
+    stateBit_ = LsfSpan<unsigned char>(stateBit, n);
+    user_     = LsfSpan<unsigned>(user, n);
+}
+
+
+void lsfutil::LsfJobColumns::clear()
+{
+    jobId_    = LsfSpan<int>();
+    stateBit_ = LsfSpan<unsigned char>();
+    user_     = LsfSpan<unsigned>();
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,157 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfJobColumns
+
+Description
+    The frequently filtered fields of an lsfutil::LsfJobList, one column
+    (contiguous array) per field.
+
+    Each lsfutil::LsfJobEntry holds dozens of strings, so scanning the
+    jobs for a few small fields touches a lot of memory. The columns are
+    built once per snapshot, in its arena. A selection is a Mask of one
+    byte per job, narrowed column by column with simple loops. The jobs
+    that remain are then collected in job order.
+
+SourceFiles
+    LsfJobColumns.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_JOB_COLUMNS_H
+#define LSF_JOB_COLUMNS_H
+
+#include <vector>
+
+#include "lsfutil/LsfArena.hpp"
+#include "lsfutil/LsfJobList.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class LsfJobColumns Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfJobColumns
+{
+public:
+
+    //- A selection of jobs, non-zero for a selected job
+    typedef std::vector<unsigned char> Mask;
+
+
+private:
+
+    // Private data
+
+        //- The job ids
+        LsfSpan<int> jobId_;
+
+        //- The simplified job status, as a single bit
+        //  (1 << LsfJobEntry::StatusType)
+        LsfSpan<unsigned char> stateBit_;
+
+        //- The users (string pool ids)
+        LsfSpan<unsigned> user_;
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        LsfJobColumns();
+
+        //- Construct for the given jobs, in the arena
+        LsfJobColumns(const LsfJobList&, LsfArena&);
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of jobs
+            unsigned size() const
+            {
+                return jobId_.size();
+            }
+
+            const LsfSpan<int>& jobId() const
+            {
+                return jobId_;
+            }
+
+            const LsfSpan<unsigned char>& stateBit() const
+            {
+                return stateBit_;
+            }
+
+            const LsfSpan<unsigned>& user() const
+            {
+                return user_;
+            }
+
+
+        // Selection
+
+            //- Select all jobs
+            void selectAll(Mask&) const;
+
+            //- Keep the jobs with a status in the given bit set,
+            //  with bit (1 << LsfJobEntry::StatusType) for each status
+            void keepStates(Mask&, unsigned states) const;
+
+            //- Keep the jobs of the users that are non-zero in the given
+            //  table, indexed by string pool id
+            void keepUsers(Mask&, const std::vector<unsigned char>&) const;
+
+            //- Keep the jobs with one of the given (sorted) job ids
+            void keepJobIds(Mask&, const std::vector<int>&) const;
+
+            //- The number of jobs selected
+            static unsigned count(const Mask&);
+
+            //- The indices of the jobs selected, in job order
+            static void selected(const Mask&, std::vector<int>&);
+
+
+        // Edit
+
+            //- Rebuild for the given jobs, in the arena
+            void build(const LsfJobList&, LsfArena&);
+
+            //- Clear the columns, their arrays remain in the arena
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_JOB_COLUMNS_H
+
+// ************************************************************************* //
@@ -22,45 +22,126 @@ License
 #include "lsfutil/LsfJobEntry.hpp"
 
 #include <cstring>
+
+#ifndef WITHOUT_LSF
 #include <lsf/lsbatch.h>
+#endif
+
+
+//! \cond local scope
+
+// the names of the simplified status, in the order of StatusType
+static const char* const statusNames_[] =
+{
+    "unknown",
+    "pending",
+    "done",
+    "suspended",
+    "running"
+};
+
+static const unsigned nStatusNames_ =
+    sizeof(statusNames_) / sizeof(statusNames_[0]);
+
+//! \endcond
 
 
 // * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
 
-std::string lsfutil::LsfJobEntry::jobStatusToString(int stat)
+#ifndef WITHOUT_LSF
+lsfutil::LsfJobEntry::StatusType lsfutil::LsfJobEntry::jobStatus(int stat)
 {
     if (IS_PEND(stat))
     {
-        return "pending";
+        return PENDING;
     }
     else if (IS_FINISH(stat))
     {
-        return "done";
+        return DONE;
     }
     else if (IS_SUSP(stat))
     {
-        return "suspended";
+        return SUSPENDED;
     }
     else if (IS_START(stat))
     {
-        return "running";
+        return RUNNING;
     }
     else
     {
-        return "unknown";
+        return UNKNOWN;
+    }
+}
+#endif
+
+
+lsfutil::LsfJobEntry::StatusType
+lsfutil::LsfJobEntry::lookupStatus(const std::string& name)
+{
+    for (unsigned i = 1; i < nStatusNames_; ++i)
+    {
+        if (name == statusNames_[i])
+        {
+            return StatusType(i);
+        }
     }
+
+    return UNKNOWN;
+}
+
+
+const char* lsfutil::LsfJobEntry::statusName(StatusType type)
+{
+    return
+    (
+        unsigned(type) < nStatusNames_
+      ? statusNames_[type]
+      : statusNames_[UNKNOWN]
+    );
 }
 
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
-lsfutil::LsfJobEntry::LsfJobEntry(const struct jobInfoEnt& job)
+lsfutil::LsfJobEntry::LsfJobEntry()
 :
-    submit(job.submit),
+    submit(),
+    jobId(0),
+    taskId(0),
+    statusBits(0),
+    statusType(UNKNOWN),
+    user(0),
+    submitTime(0),
+    reserveTime(0),
+    startTime(0),
+    predictedStartTime(0),
+    endTime(0),
+    duration(0),
+    cpuTime(0),
+    umask(0),
+    cwd(),
+    subHomeDir(),
+    fromHost(0),
+    exitStatus(0),
+    execHome(),
+    execRusage(),
+    execHosts()
+{}
+
+
+#ifndef WITHOUT_LSF
+lsfutil::LsfJobEntry::LsfJobEntry
+(
+    const struct jobInfoEnt& job,
+    LsfStringPool& pool
+)
+:
+    submit(job.submit, pool),
     jobId(LSB_ARRAY_JOBID(job.jobId)),
     taskId(LSB_ARRAY_IDX(job.jobId)),
-    status(jobStatusToString(job.status)),
-    user(makeString(job.user)),
+    statusBits(job.status),
+    statusType(jobStatus(job.status)),
+    user(pool.intern(job.user)),
     submitTime(job.submitTime),
     reserveTime(job.reserveTime),
     startTime(job.startTime),
@@ -69,44 +150,55 @@ lsfutil::LsfJobEntry::LsfJobEntry(const struct jobInfoEnt& job)
     duration(job.duration),
     cpuTime(job.cpuTime),
     umask(job.umask),
-    cwd(makeString(job.cwd)),
-    subHomeDir(makeString(job.subHomeDir)),
-    fromHost(makeString(job.fromHost)),
+    cwd(),
+    subHomeDir(),
+    fromHost(pool.intern(job.fromHost)),
     exitStatus(job.exitStatus),
-    execHome(makeString(job.execHome)),
-    execRusage(makeString(job.execRusage)),
+    execHome(pool.store(job.execHome)),
+    execRusage(pool.store(job.execRusage)),
     execHosts()
 {
-    fixDirName(cwd);
-    fixDirName(subHomeDir);
+    std::string dir  = makeString(job.cwd);
+    std::string home = makeString(job.subHomeDir);
+
+    fixDirName(dir);
+    fixDirName(home);
 
     // relative CWD? - assume it was relative to subHomeDir
-    if (cwd.size() && cwd[0] != '/' && subHomeDir.size())
+    if (dir.size() && dir[0] != '/' && home.size())
     {
-        cwd = subHomeDir + '/' + cwd;
+        dir = home + '/' + dir;
     }
 
+    cwd = pool.store(dir);
+    subHomeDir = pool.store(home);
+
     if (job.numExHosts)
     {
-        execHosts.reserve(job.numExHosts);
-
-        // Host list when job starts
+        // Host list when job starts, once per slot
+        std::vector<unsigned> slotHosts(job.numExHosts);
         for (int i=0; i < job.numExHosts; ++i)
         {
-            execHosts.push_back((job.exHosts)[i]);
+            slotHosts[i] = pool.intern((job.exHosts)[i]);
         }
+
+        setExecHosts(slotHosts, pool);
     }
 
     // replace %J with jobId and %I with taskId immediately
-    replaceAll(submit.outFile, "%J", makeString(jobId));
-    replaceAll(submit.outFile, "%I", makeString(taskId));
+    std::string out = submit.outFile.str();
+    std::string err = submit.errFile.str();
+
+    replaceAll(out, "%J", makeString(jobId));
+    replaceAll(out, "%I", makeString(taskId));
 
-    replaceAll(submit.errFile, "%J", makeString(jobId));
-    replaceAll(submit.errFile, "%I", makeString(taskId));
+    replaceAll(err, "%J", makeString(jobId));
+    replaceAll(err, "%I", makeString(taskId));
 
-    submit.outFile = this->relativeFilePath(submit.outFile);
-    submit.errFile = this->relativeFilePath(submit.errFile);
+    submit.outFile = pool.store(this->relativeFilePath(out));
+    submit.errFile = pool.store(this->relativeFilePath(err));
 }
+#endif
 
 
 // * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
@@ -130,7 +222,7 @@ std::string lsfutil::LsfJobEntry::relativeFilePath
     (
         relName.size() > cwd.size()+1
      && relName[cwd.size()] == '/'
-     && relName.substr(0, cwd.size()) == cwd
+     && relName.compare(0, cwd.size(), cwd.data(), cwd.size()) == 0
     )
     {
         relName.erase(0, cwd.size()+1);
@@ -157,38 +249,57 @@ std::string lsfutil::LsfJobEntry::fqJobId() const
 }
 
 
-bool lsfutil::LsfJobEntry::isPending() const
+unsigned lsfutil::LsfJobEntry::execSlots() const
 {
-    return status == "pending";
-}
-
-
-bool lsfutil::LsfJobEntry::isDone() const
-{
-    return status == "done";
+    unsigned n = 0;
+    for (unsigned i=0; i < execHosts.size(); ++i)
+    {
+        n += execHosts[i].slots;
+    }
+    return n;
 }
 
 
-bool lsfutil::LsfJobEntry::isSuspend() const
+void lsfutil::LsfJobEntry::setExecHosts
+(
+    const std::vector<unsigned>& slotHosts,
+    LsfStringPool& pool
+)
 {
-    return status == "suspended";
-}
+    std::vector<ExecHost> runs;
 
+    for (unsigned i=0; i < slotHosts.size(); ++i)
+    {
+        if (!runs.empty() && runs.back().host == slotHosts[i])
+        {
+            ++runs.back().slots;
+        }
+        else
+        {
+            ExecHost run;
+            run.host  = slotHosts[i];
+            run.slots = 1;
+            runs.push_back(run);
+        }
+    }
 
-bool lsfutil::LsfJobEntry::isRunning() const
-{
-    return status == "running";
+    execHosts = pool.store(runs);
 }
 
 
-std::ostream& lsfutil::LsfJobEntry::dump(std::ostream& os) const
+std::ostream& lsfutil::LsfJobEntry::dump
+(
+    std::ostream& os,
+    const LsfStringPool& pool
+) const
 {
     os  << "jobId: " << jobId << "\n";
     os  << "taskId: " << taskId << "\n";
-    os  << "status: " << status << "\n";
-    submit.dump(os);
+    os  << "status: " << status() << "\n";
+    os  << "statusBits: " << statusBits << "\n";
+    submit.dump(os, pool);
 
-    os  << "user: " << user << "\n";
+    os  << "user: " << pool[user] << "\n";
     os  << "submitTime: " << submitTime << "\n";
     os  << "reserveTime: " << reserveTime << "\n";
     os  << "startTime: " << startTime << "\n";
@@ -197,20 +308,25 @@ std::ostream& lsfutil::LsfJobEntry::dump(std::ostream& os) const
     os  << "duration: " << duration << "\n";
     os  << "cpuTime: " << cpuTime << "\n";
     os  << "umask: " << umask << "\n";
-    os  << "job-cwd: " << cwd << "\n";
-    os  << "subHomeDir: " << subHomeDir << "\n";
-    os  << "fromHost: " << fromHost << "\n";
-    os  << "execHome: " << execHome << "\n";
-    os  << "execRusage: " << execRusage << "\n";
+    os  << "job-cwd: " << escape(cwd.str()) << "\n";
+    os  << "subHomeDir: " << escape(subHomeDir.str()) << "\n";
+    os  << "fromHost: " << pool[fromHost] << "\n";
+    os  << "execHome: " << escape(execHome.str()) << "\n";
+    os  << "execRusage: " << escape(execRusage.str()) << "\n";
 
     os  << "execHosts: (";
     for (unsigned i=0; i < execHosts.size(); ++i)
     {
-        if (i)
+        const LsfText& name = pool[execHosts[i].host];
+
+        for (unsigned slotI=0; slotI < execHosts[i].slots; ++slotI)
         {
-            os  << ' ';
+            if (i || slotI)
+            {
+                os  << ' ';
+            }
+            os  << name;
         }
-        os  << execHosts[i];
     }
     os  << ")\n";
 
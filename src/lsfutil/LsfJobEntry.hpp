@@ -27,6 +27,12 @@ Description
     allocation/de-allocation issues and provide other C++ conveniences,
     almost all information is available directly as public members.
 
+    The user, the submission host and the execution hosts are ids in the
+    lsfutil::LsfStringPool of the job list. Since LSF lists an execution
+    host once per slot, the execution hosts are kept as runs of slots.
+    The other text is stored in the string pool as well, so the entries
+    are only valid for as long as their pool.
+
 \*---------------------------------------------------------------------------*/
 
 #ifndef LSF_JOB_ENTRY_H
@@ -63,12 +69,47 @@ class LsfJobEntry
     // Private Data
 
 
+public:
+
+    //- The job status, simplified from the LSF status bits
+    enum StatusType
+    {
+        UNKNOWN = 0,  //!< unknown/invalid
+        PENDING,
+        DONE,
+        SUSPENDED,
+        RUNNING
+    };
+
+    //- A run of consecutive job slots on an execution host
+    struct ExecHost
+    {
+        //- The host (string pool id)
+        unsigned host;
+
+        //- The number of slots
+        unsigned slots;
+    };
+
+
+private:
+
     // Private Member Functions
 
-        static std::string jobStatusToString(int);
+        //- The simplified status for the LSF status bits
+        static StatusType jobStatus(int);
+
 
 public:
-    // Static data members
+
+    // Static Member Functions
+
+        //- Lookup the simplified status from its name,
+        //  UNKNOWN if not found
+        static StatusType lookupStatus(const std::string&);
+
+        //- The name of the simplified status
+        static const char* statusName(StatusType);
 
 
     // Public data
@@ -80,10 +121,14 @@ public:
         int jobId;
         int taskId;
 
-        std::string status;
+        //- The LSF job status bits (JOB_STAT_*), 0 if not known
+        int statusBits;
 
-        //- The name of the user who submitted the job
-        std::string user;
+        //- The simplified job status
+        StatusType statusType;
+
+        //- The name of the user who submitted the job (string pool id)
+        unsigned user;
 
         //- The time the job was submitted, in seconds since 00:00:00 GMT, Jan. 1, 1970.
         time_t submitTime;
@@ -110,31 +155,35 @@ public:
         int umask;
 
         //- The current working directory when the job was submitted.
-        std::string cwd;
+        LsfText cwd;
 
         //- Home directory on submission host.
-        std::string subHomeDir;
+        LsfText subHomeDir;
 
         //- The name of the host from which the job was submitted.
-        std::string fromHost;
+        //  (string pool id)
+        unsigned fromHost;
 
         //- Job exit status
         int exitStatus;
 
         //- Home directory for the job on the execution host
-        std::string execHome;
+        LsfText execHome;
 
         //- The rusage satisfied at job runtime
-        std::string execRusage;
+        LsfText execRusage;
 
-        //- Host list for job
-        std::vector<std::string> execHosts;
+        //- Host list for job, as runs of slots on the same host
+        LsfSpan<ExecHost> execHosts;
 
 
     // Constructors
 
-        //- Construct from jobInfoEnt
-        LsfJobEntry(const jobInfoEnt&);
+        //- Construct null
+        LsfJobEntry();
+
+        //- Construct from jobInfoEnt, storing the text in the given pool
+        LsfJobEntry(const jobInfoEnt&, LsfStringPool&);
 
 
     //- Destructor
@@ -154,6 +203,15 @@ public:
             //- The jobid as a string
             std::string tokenJ() const;
 
+            //- The name of the simplified job status
+            const char* status() const
+            {
+                return statusName(statusType);
+            }
+
+            //- The number of slots on all execution hosts
+            unsigned execSlots() const;
+
 
         // Check
 
@@ -162,16 +220,39 @@ public:
                 return taskId > 0;
             }
 
-            bool isPending() const;
-            bool isDone() const;
-            bool isSuspend() const;
-            bool isRunning() const;
+            inline bool isPending() const
+            {
+                return statusType == PENDING;
+            }
+
+            inline bool isDone() const
+            {
+                return statusType == DONE;
+            }
+
+            inline bool isSuspend() const
+            {
+                return statusType == SUSPENDED;
+            }
+
+            inline bool isRunning() const
+            {
+                return statusType == RUNNING;
+            }
+
+
+        // Edit
+
+            //- Set the execution hosts from the host of each slot
+            //  (string pool ids), storing the runs of slots in the pool
+            void setExecHosts(const std::vector<unsigned>&, LsfStringPool&);
 
 
         // Write
 
-            //- Raw dump of information in text format
-            std::ostream& dump(std::ostream&) const;
+            //- Raw dump of information in text format,
+            //  a "key: value" line each with the text escape()d
+            std::ostream& dump(std::ostream&, const LsfStringPool&) const;
 
 };
 
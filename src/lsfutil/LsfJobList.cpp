@@ -22,7 +22,6 @@ License
 #include "lsfutil/LsfJobList.hpp"
 
 #include <ctime>
-#include <lsf/lsbatch.h>
 
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
@@ -33,15 +32,30 @@ lsfutil::LsfJobList::LsfJobList(unsigned interval, bool withPending)
     lastUpdate_(0),
     interval_(interval),
     error_(false),
-    options_(CUR_JOB)
+    withPending_(withPending),
+    source_(LsfDataSource::defaultSource()),
+    strings_()
 {
-    if (withPending)
-    {
-        options_ |= PEND_JOB;   // include pending jobs
-    }
-
     this->update();
+}
 
+
+lsfutil::LsfJobList::LsfJobList
+(
+    LsfDataSource& source,
+    unsigned interval,
+    bool withPending
+)
+:
+    std::vector<lsfutil::LsfJobEntry>(),
+    lastUpdate_(0),
+    interval_(interval),
+    error_(false),
+    withPending_(withPending),
+    source_(source),
+    strings_()
+{
+    this->update();
 }
 
 
@@ -65,32 +79,10 @@ bool lsfutil::LsfJobList::update()
         lastUpdate_ = now;
 
         this->clear();
+        strings_.clear();
 
-        if (lsb_init("lsfutil::LsfJobList::update()") < 0)
-        {
-            error_ = true;
-        }
-        else
-        {
-            int nJobs = lsb_openjobinfo(0, NULL, "all", NULL, NULL, options_);
-            // gets the total number of jobs, -1 on failure
-
-            if (nJobs >= 0)
-            {
-                this->reserve(nJobs);
-                while (nJobs > 0)
-                {
-                    const struct jobInfoEnt *job = lsb_readjobinfo(&nJobs);
-                    if (job)
-                    {
-                        this->push_back(lsfutil::LsfJobEntry(*job));
-                    }
-                }
-
-                // close the connection
-                lsb_closejobinfo();
-            }
-        }
+        std::vector<lsfutil::LsfJobEntry>& list = *this;
+        error_ = !source_.fetchJobs(list, strings_, withPending_);
     }
 
     return updated;
@@ -105,7 +97,7 @@ std::ostream& lsfutil::LsfJobList::dump(std::ostream& os) const
         {
             os  << "==================================================\n";
         }
-        this->operator[](jobI).dump(os);
+        this->operator[](jobI).dump(os, strings_);
         os  << "==================================================\n";
     }
 
@@ -23,6 +23,9 @@ Class
 Description
     A list of lsfutil::LsfJobEntry elements.
 
+    The strings that repeat across the jobs are interned into a string
+    pool that belongs to the list, and the jobs refer to them by id.
+
 \*---------------------------------------------------------------------------*/
 
 #ifndef LSF_JOB_LIST_H
@@ -33,6 +36,8 @@ Description
 #include <iostream>
 
 #include "lsfutil/LsfJobEntry.hpp"
+#include "lsfutil/LsfStringPool.hpp"
+#include "lsfutil/LsfDataSource.hpp"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -62,8 +67,14 @@ class LsfJobList
         //! Error
         bool error_;
 
-        //! variables for simulating bjobs command
-        int options_;
+        //! Include pending jobs
+        bool withPending_;
+
+        //! The source of the job information
+        LsfDataSource& source_;
+
+        //! The strings interned by the jobs
+        LsfStringPool strings_;
 
 public:
 
@@ -73,6 +84,14 @@ public:
         //  In the future, allow for internal caching
         LsfJobList(unsigned interval = 10, bool withPending = true);
 
+        //! Construct from a specific data source
+        LsfJobList
+        (
+            LsfDataSource&,
+            unsigned interval = 10,
+            bool withPending = true
+        );
+
 
     //! Destructor
     ~LsfJobList();
@@ -86,6 +105,18 @@ public:
             using std::vector<lsfutil::LsfJobEntry>::size;
             using std::vector<lsfutil::LsfJobEntry>::operator[];
 
+            //- The strings interned by the jobs
+            const LsfStringPool& strings() const
+            {
+                return strings_;
+            }
+
+            //- The interned string with the given id
+            const LsfText& str(unsigned id) const
+            {
+                return strings_[id];
+            }
+
 
         // Check
 
@@ -21,50 +21,91 @@ License
 
 #include "lsfutil/LsfJobSubEntry.hpp"
 
+#include <cstring>
 #include <iostream>
+
+#ifndef WITHOUT_LSF
 #include <lsf/lsbatch.h>
+#endif
 
 
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
-lsfutil::LsfJobSubEntry::LsfJobSubEntry(const struct submit& sub)
+lsfutil::LsfJobSubEntry::LsfJobSubEntry()
 :
-    jobName(sub.jobName),
-    queue(sub.queue),
+    jobName(),
+    queue(0),
+    numProcessors(1),
+    dependCond(),
+    beginTime(0),
+    termTime(0),
+    inFile(),
+    outFile(),
+    errFile(),
+    command(),
+    chkpntDir(),
+    preExecCmd(),
+    mailUser(),
+    projectName(0),
+    loginShell(),
+    userGroup(),
+    jobGroup(),
+    licenseProject(),
+    app(),
+    postExecCmd(),
+    cwd(),
+    notifyCmd(),
+    jobDescription(),
+    resReq(),
+    rusage(),
+    askedHosts()
+{}
+
+
+#ifndef WITHOUT_LSF
+lsfutil::LsfJobSubEntry::LsfJobSubEntry
+(
+    const struct submit& sub,
+    LsfStringPool& pool
+)
+:
+    jobName(pool.store(sub.jobName)),
+    queue(pool.intern(sub.queue)),
     numProcessors(sub.numProcessors),
-    dependCond(sub.dependCond),
+    dependCond(pool.store(sub.dependCond)),
     beginTime(sub.beginTime),
     termTime(sub.termTime),
-    inFile(makeString(sub.inFile)),
-    outFile(makeString(sub.outFile)),
-    errFile(makeString(sub.errFile)),
-    command(makeString(sub.command)),
-    chkpntDir(makeString(sub.chkpntDir)),
-    preExecCmd(makeString(sub.preExecCmd)),
-    mailUser(makeString(sub.mailUser)),
-    projectName(makeString(sub.projectName)),
-    loginShell(makeString(sub.loginShell)),
-    userGroup(makeString(sub.userGroup)),
-    jobGroup(makeString(sub.jobGroup)),
-    licenseProject(makeString(sub.licenseProject)),
-    app(makeString(sub.app)),
-    postExecCmd(makeString(sub.postExecCmd)),
-    cwd(makeString(sub.cwd)),
-    notifyCmd(makeString(sub.notifyCmd)),
-    jobDescription(makeString(sub.jobDescription)),
+    inFile(),
+    outFile(),
+    errFile(),
+    command(),
+    chkpntDir(pool.store(sub.chkpntDir)),
+    preExecCmd(pool.store(sub.preExecCmd)),
+    mailUser(pool.store(sub.mailUser)),
+    projectName(pool.intern(sub.projectName)),
+    loginShell(pool.store(sub.loginShell)),
+    userGroup(pool.store(sub.userGroup)),
+    jobGroup(pool.store(sub.jobGroup)),
+    licenseProject(pool.store(sub.licenseProject)),
+    app(pool.store(sub.app)),
+    postExecCmd(pool.store(sub.postExecCmd)),
+    cwd(),
+    notifyCmd(pool.store(sub.notifyCmd)),
+    jobDescription(pool.store(sub.jobDescription)),
     resReq(),
+    rusage(),
     askedHosts()
 {
-
-    std::string::size_type eolp = command.find('\n');
-    if (eolp != std::string::npos)
+    if (sub.command)
     {
-        command.resize(eolp);
-    }
-    else if (command.size() > 256)
-    {
-        // truncate for really long commands (eg, shell files)
-        command.resize(256);
+        size_t len = strcspn(sub.command, "\n");
+        if (!sub.command[len] && len > 256)
+        {
+            // truncate for really long commands (eg, shell files)
+            len = 256;
+        }
+
+        command = pool.store(sub.command, len);
     }
 
     // The number of invoker specified candidate hosts for running
@@ -72,35 +113,50 @@ lsfutil::LsfJobSubEntry::LsfJobSubEntry(const struct submit& sub)
     // considered
     if (sub.numAskedHosts)
     {
-        askedHosts.reserve(sub.numAskedHosts);
+        std::vector<unsigned> hosts(sub.numAskedHosts);
 
         // The array of names of invoker specified candidate hosts.
         // The number of hosts is given by numAskedHosts.
         for (int i=0; i < sub.numAskedHosts; ++i)
         {
-            askedHosts.push_back((sub.askedHosts)[i]);
+            hosts[i] = pool.intern((sub.askedHosts)[i]);
         }
+
+        askedHosts = pool.store(hosts);
     }
 
 //    timeEvent_ = sub.timeEvent;
-    resReq = sub.resReq;
-
-    fixDirName(cwd);
-    fixFileName(inFile);
-    fixFileName(outFile);
-    fixFileName(errFile);
-
-    if (inFile == "/dev/null")
+    const std::string req = makeString(sub.resReq);
+    resReq = pool.store(req);
+    rusage.parse(req, pool);
+
+    // the file names are adjusted before storing
+    std::string dir = makeString(sub.cwd);
+    std::string in  = makeString(sub.inFile);
+    std::string out = makeString(sub.outFile);
+    std::string err = makeString(sub.errFile);
+
+    fixDirName(dir);
+    fixFileName(in);
+    fixFileName(out);
+    fixFileName(err);
+
+    if (in == "/dev/null")
     {
-        inFile.clear();
+        in.clear();
     }
 
-    if (errFile == outFile)
+    if (err == out)
     {
-        errFile.clear();
+        err.clear();
     }
 
+    cwd = pool.store(dir);
+    inFile = pool.store(in);
+    outFile = pool.store(out);
+    errFile = pool.store(err);
 }
+#endif
 
 
 // * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
@@ -111,50 +167,45 @@ lsfutil::LsfJobSubEntry::~LsfJobSubEntry()
 
 // * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
 
-std::ostream& lsfutil::LsfJobSubEntry::dump(std::ostream& os) const
+std::ostream& lsfutil::LsfJobSubEntry::dump
+(
+    std::ostream& os,
+    const LsfStringPool& pool
+) const
 {
-    os  << "jobName: " << jobName << "\n"
-        << "queue: " << queue << "\n"
+    os  << "jobName: " << escape(jobName.str()) << "\n"
+        << "queue: " << pool[queue] << "\n"
         << "numProcessors: " << numProcessors << "\n"
-        << "dependCond: " << dependCond << "\n"
+        << "dependCond: " << escape(dependCond.str()) << "\n"
         << "beginTime: " << beginTime << "\n"
         << "termTime: " << termTime << "\n"
-        << "inFile: " << inFile << "\n"
-        << "outFile: " << outFile << "\n"
-        << "errFile: " << errFile << "\n";
-
-    if (command.size() && command[0] == '#')
-    {
-        os  << "command: STDIN\n";
-    }
-    else
-    {
-        os  << "command: " << command << "\n";
-    }
-
-    os  << "chkpntDir: " << chkpntDir << "\n"
-        << "preExecCmd: " << preExecCmd << "\n"
-        << "mailUser: " << mailUser << "\n"
-        << "projectName: " << projectName << "\n"
-        << "loginShell: " << loginShell << "\n"
-        << "userGroup: " << userGroup << "\n"
-        << "jobGroup: " << jobGroup << "\n"
-        << "licenseProject: " << licenseProject << "\n"
-        << "app: " << app << "\n"
-        << "postExecCmd: " << postExecCmd << "\n"
-        << "cwd: " << cwd << "\n"
-        << "notifyCmd: " << notifyCmd << "\n"
-        << "jobDescription: " << jobDescription << "\n"
-        << "resReq: " << resReq << "\n";
+        << "inFile: " << escape(inFile.str()) << "\n"
+        << "outFile: " << escape(outFile.str()) << "\n"
+        << "errFile: " << escape(errFile.str()) << "\n"
+        << "command: " << escape(command.str()) << "\n"
+        << "chkpntDir: " << escape(chkpntDir.str()) << "\n"
+        << "preExecCmd: " << escape(preExecCmd.str()) << "\n"
+        << "mailUser: " << escape(mailUser.str()) << "\n"
+        << "projectName: " << pool[projectName] << "\n"
+        << "loginShell: " << escape(loginShell.str()) << "\n"
+        << "userGroup: " << escape(userGroup.str()) << "\n"
+        << "jobGroup: " << escape(jobGroup.str()) << "\n"
+        << "licenseProject: " << escape(licenseProject.str()) << "\n"
+        << "app: " << escape(app.str()) << "\n"
+        << "postExecCmd: " << escape(postExecCmd.str()) << "\n"
+        << "cwd: " << escape(cwd.str()) << "\n"
+        << "notifyCmd: " << escape(notifyCmd.str()) << "\n"
+        << "jobDescription: " << escape(jobDescription.str()) << "\n"
+        << "resReq: " << escape(resReq.str()) << "\n";
 
     os  << "askedHosts: (";
-    for (unsigned i=0; i << askedHosts.size(); ++i)
+    for (unsigned i=0; i < askedHosts.size(); ++i)
     {
         if (i)
         {
             os  << ' ';
         }
-        os  << askedHosts[i];
+        os  << pool[askedHosts[i]];
     }
     os  << ")\n";
 
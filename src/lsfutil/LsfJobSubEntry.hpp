@@ -27,6 +27,9 @@ Description
     allocation/de-allocation issues and provide other C++ conveniences,
     almost all information is available directly as public members.
 
+    The queue and project names are ids in the lsfutil::LsfStringPool
+    of the job list, which also stores the other text.
+
 \*---------------------------------------------------------------------------*/
 
 #ifndef LSF_JOB_SUB_ENTRY_H
@@ -38,6 +41,8 @@ Description
 #include <iostream>
 
 #include "lsfutil/LsfCore.hpp"
+#include "lsfutil/LsfRusage.hpp"
+#include "lsfutil/LsfStringPool.hpp"
 
 // Forward declaration of classes
 struct submit;
@@ -70,18 +75,18 @@ public:
     // Public data
 
         //- The job name. If jobName is empty, command is used as the job name.
-        std::string jobName;
+        LsfText jobName;
 
         //- Submit the job to this queue. If queue is NULL, submit the job
-        // to a system default queue.
-        std::string queue;
+        // to a system default queue. (string pool id)
+        unsigned queue;
 
         //- The initial number of processors needed by a (parallel) job.
         //  The default is 1.
         int numProcessors;
 
         //- The job dependency condition.
-        std::string dependCond;
+        LsfText dependCond;
 
 
         //- Time when job slots are reserved
@@ -103,77 +108,84 @@ public:
 
         //- The path name of the job's standard input file.
         //  If inFile is NULL, use /dev/null as the default.
-        std::string inFile;
+        LsfText inFile;
 
         //- The path name of the job's standard output file.
         //  If outFile is NULL, the job's output will be mailed to the submitter
-        std::string outFile;
+        LsfText outFile;
 
         //- The path name of the job's standard error output file.
         //  If errFile is NULL, the standard error output will be merged with the standard output of the job.
-        std::string errFile;
+        LsfText errFile;
 
         //- When submitting a job, the command line of the job.
         //  When modifying a job, a mandatory parameter that should be set to jobId in string format.
-        std::string command;
+        LsfText command;
 
 
         //- Where the chk directory for this job checkpoint files will be created.
         //  When a job is checkpointed, its
         //  checkpoint files are placed in chkpntDir/chk. chkpntDir can be
         //  a relative or absolute path name.
-        std::string chkpntDir;
+        LsfText chkpntDir;
 
         //- The job pre-execution command
-        std::string preExecCmd;
+        LsfText preExecCmd;
 
         //- The user that results are mailed to
-        std::string mailUser;
+        LsfText mailUser;
 
         //- The name of the project the job will be charged to.
-        std::string projectName;
+        //  (string pool id)
+        unsigned projectName;
 
         //- Specified login shell used to initialize the execution
         //  environment for the job (see the -L option of bsub).
-        std::string loginShell;
+        LsfText loginShell;
 
         //- The name of the LSF user group (see lsb.users) to which the
         //  job will belong. (see the -G option of bsub)
-        std::string userGroup;
+        LsfText userGroup;
 
         //- Job group under which the job runs.
-        std::string jobGroup;
+        LsfText jobGroup;
 
         //- License Scheduler project name
-        std::string licenseProject;
+        LsfText licenseProject;
 
         //- Application profile under which the job runs.
-        std::string app;
+        LsfText app;
 
         //- Post-execution commands specified by -Ep option of bsub and bmod.
-        std::string postExecCmd;
+        LsfText postExecCmd;
 
         //- Current working directory specified by -cwd option of bsub and bmod.
-        std::string cwd;
+        LsfText cwd;
 
         //- Job resize notification command to be invoked on the first
         //  execution host when a resize request has been satisfied.
-        std::string notifyCmd;
+        LsfText notifyCmd;
 
         //- Job description.
-        std::string jobDescription;
+        LsfText jobDescription;
 
         //- Resource Request.
-        std::string resReq;
+        LsfText resReq;
+
+        //- The rusage requests of resReq, parsed once
+        LsfRusage rusage;
 
-        //- List of specified candidate hosts.
-        std::vector<std::string> askedHosts;
+        //- List of specified candidate hosts. (string pool ids)
+        LsfSpan<unsigned> askedHosts;
 
 
     // Constructors
 
-        //- Construct from submit
-        LsfJobSubEntry(const submit&);
+        //- Construct null
+        LsfJobSubEntry();
+
+        //- Construct from submit, storing the text in the given pool
+        LsfJobSubEntry(const submit&, LsfStringPool&);
 
 
     //- Destructor
@@ -184,8 +196,9 @@ public:
 
         // Write
 
-            //- Raw dump of information in text format
-            std::ostream& dump(std::ostream&) const;
+            //- Raw dump of information in text format,
+            //  a "key: value" line each with the text escape()d
+            std::ostream& dump(std::ostream&, const LsfStringPool&) const;
 
 };
 
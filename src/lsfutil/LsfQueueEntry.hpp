@@ -0,0 +1,95 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfQueueEntry
+
+Description
+    Encapsulation of the parts of the LSF \c queueInfoEnt structure
+    that we use.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_QUEUE_ENTRY_H
+#define LSF_QUEUE_ENTRY_H
+
+#include <string>
+#include <iostream>
+
+#include "lsfutil/LsfCore.hpp"
+
+// Forward declaration of classes
+struct queueInfoEnt;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                    Class LsfQueueEntry Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfQueueEntry
+:
+    public LsfCore
+{
+public:
+
+    // Public data
+
+        //- The queue name
+        std::string name;
+
+        //- The space-delimited list of hosts used by the queue
+        std::string hostList;
+
+
+    // Constructors
+
+        //! Construct null
+        LsfQueueEntry();
+
+        //! Construct from queueInfoEnt
+        LsfQueueEntry(const queueInfoEnt&);
+
+
+    //! Destructor
+    ~LsfQueueEntry();
+
+
+    // Member Functions
+
+        // Write
+
+            //- Raw dump of information in text format
+            std::ostream& dump(std::ostream&) const;
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_QUEUE_ENTRY_H
+
+// ************************************************************************* //
@@ -0,0 +1,474 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfReplaySource.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+
+//! \cond local scope
+
+static const char* const separator_ =
+    "==================================================\n";
+
+
+// the recorded files, which are first written with a ".new" suffix
+static const char* const files_[] =
+{
+    "jobs", "hosts", "queues", "hostgroups"
+};
+static const unsigned nFiles_ = sizeof(files_)/sizeof(files_[0]);
+
+
+static int toInt(const std::string& str)
+{
+    return ::strtol(str.c_str(), NULL, 10);
+}
+
+
+static float toFloat(const std::string& str)
+{
+    return ::strtod(str.c_str(), NULL);
+}
+
+
+// a host list written as "(name1 name2 ...)"
+static std::vector<std::string> toList(const std::string& str)
+{
+    std::string::size_type beg = str.find('(');
+    std::string::size_type end = str.rfind(')');
+
+    beg = (beg == std::string::npos ? 0 : beg + 1);
+    if (end == std::string::npos || end < beg)
+    {
+        end = str.size();
+    }
+
+    return lsfutil::LsfCore::parseSpaceDelimited(str.substr(beg, end - beg));
+}
+
+
+// a host list written as "(name1 name2 ...)", interned into the pool
+static std::vector<unsigned> toIds
+(
+    const std::string& str,
+    lsfutil::LsfStringPool& pool
+)
+{
+    const std::vector<std::string> names = toList(str);
+
+    std::vector<unsigned> ids(names.size());
+    for (unsigned i = 0; i < names.size(); ++i)
+    {
+        ids[i] = pool.intern(names[i]);
+    }
+
+    return ids;
+}
+
+
+// the context for records without interned strings
+struct NoContext {};
+
+
+static void setEntry
+(
+    lsfutil::LsfJobSubEntry& sub,
+    const std::string& key,
+    const std::string& val,
+    lsfutil::LsfStringPool& pool
+)
+{
+    if      (key == "jobName")        { sub.jobName = pool.store(val); }
+    else if (key == "queue")          { sub.queue = pool.intern(val); }
+    else if (key == "numProcessors")  { sub.numProcessors = toInt(val); }
+    else if (key == "dependCond")     { sub.dependCond = pool.store(val); }
+    else if (key == "beginTime")      { sub.beginTime = toInt(val); }
+    else if (key == "termTime")       { sub.termTime = toInt(val); }
+    else if (key == "inFile")         { sub.inFile = pool.store(val); }
+    else if (key == "outFile")        { sub.outFile = pool.store(val); }
+    else if (key == "errFile")        { sub.errFile = pool.store(val); }
+    else if (key == "command")        { sub.command = pool.store(val); }
+    else if (key == "chkpntDir")      { sub.chkpntDir = pool.store(val); }
+    else if (key == "preExecCmd")     { sub.preExecCmd = pool.store(val); }
+    else if (key == "mailUser")       { sub.mailUser = pool.store(val); }
+    else if (key == "projectName")    { sub.projectName = pool.intern(val); }
+    else if (key == "loginShell")     { sub.loginShell = pool.store(val); }
+    else if (key == "userGroup")      { sub.userGroup = pool.store(val); }
+    else if (key == "jobGroup")       { sub.jobGroup = pool.store(val); }
+    else if (key == "licenseProject") { sub.licenseProject = pool.store(val); }
+    else if (key == "app")            { sub.app = pool.store(val); }
+    else if (key == "postExecCmd")    { sub.postExecCmd = pool.store(val); }
+    else if (key == "cwd")            { sub.cwd = pool.store(val); }
+    else if (key == "notifyCmd")      { sub.notifyCmd = pool.store(val); }
+    else if (key == "jobDescription") { sub.jobDescription = pool.store(val); }
+    else if (key == "resReq")
+    {
+        sub.resReq = pool.store(val);
+        sub.rusage.parse(val, pool);
+    }
+    else if (key == "askedHosts")
+    {
+        sub.askedHosts = pool.store(toIds(val, pool));
+    }
+}
+
+
+static void setEntry
+(
+    lsfutil::LsfJobEntry& job,
+    const std::string& key,
+    const std::string& val,
+    lsfutil::LsfStringPool& pool
+)
+{
+    if      (key == "jobId")              { job.jobId = toInt(val); }
+    else if (key == "taskId")             { job.taskId = toInt(val); }
+    else if (key == "status")
+    {
+        job.statusType = lsfutil::LsfJobEntry::lookupStatus(val);
+    }
+    else if (key == "statusBits")         { job.statusBits = toInt(val); }
+    else if (key == "user")               { job.user = pool.intern(val); }
+    else if (key == "submitTime")         { job.submitTime = toInt(val); }
+    else if (key == "reserveTime")        { job.reserveTime = toInt(val); }
+    else if (key == "startTime")          { job.startTime = toInt(val); }
+    else if (key == "predictedStartTime")
+    {
+        job.predictedStartTime = toInt(val);
+    }
+    else if (key == "endTime")            { job.endTime = toInt(val); }
+    else if (key == "duration")           { job.duration = toInt(val); }
+    else if (key == "cpuTime")            { job.cpuTime = toFloat(val); }
+    else if (key == "umask")              { job.umask = toInt(val); }
+    else if (key == "job-cwd")            { job.cwd = pool.store(val); }
+    else if (key == "subHomeDir")         { job.subHomeDir = pool.store(val); }
+    else if (key == "fromHost")           { job.fromHost = pool.intern(val); }
+    else if (key == "execHome")           { job.execHome = pool.store(val); }
+    else if (key == "execRusage")         { job.execRusage = pool.store(val); }
+    else if (key == "execHosts")
+    {
+        job.setExecHosts(toIds(val, pool), pool);
+    }
+    else if (key == "exitStatus")         { job.exitStatus = toInt(val); }
+    else
+    {
+        setEntry(job.submit, key, val, pool);
+    }
+}
+
+
+static void setEntry
+(
+    lsfutil::LsfHostEntry& host,
+    const std::string& key,
+    const std::string& val,
+    NoContext&
+)
+{
+    // the queues are obtained separately
+    if      (key == "host")      { host.name = val; }
+    else if (key == "load 15m")  { host.load_15m = toFloat(val); }
+    else if (key == "free tmp")  { host.free_tmp = toFloat(val); }
+    else if (key == "free swap") { host.free_swp = toFloat(val); }
+    else if (key == "free mem")  { host.free_mem = toFloat(val); }
+    else if (key == "maxJobs")   { host.maxJobs = toInt(val); }
+    else if (key == "numJobs")   { host.numJobs = toInt(val); }
+    else if (key == "numRUN")    { host.numRUN = toInt(val); }
+}
+
+
+static void setEntry
+(
+    lsfutil::LsfQueueEntry& queue,
+    const std::string& key,
+    const std::string& val,
+    NoContext&
+)
+{
+    if      (key == "queue")    { queue.name = val; }
+    else if (key == "hostList") { queue.hostList = val; }
+}
+
+
+static void setEntry
+(
+    lsfutil::LsfHostGroupEntry& group,
+    const std::string& key,
+    const std::string& val,
+    NoContext&
+)
+{
+    if      (key == "hostgroup")  { group.name = val; }
+    else if (key == "memberList") { group.memberList = val; }
+}
+
+
+// read all records from a file, each "key: value" line being passed to
+// setEntry() with the value unescaped and the context.
+// Records without any keys are skipped.
+template<class Entry, class Context>
+static bool readRecords
+(
+    const std::string& file,
+    std::vector<Entry>& list,
+    Context& ctx
+)
+{
+    std::ifstream is(file.c_str());
+    if (!is)
+    {
+        return false;
+    }
+
+    Entry entry;
+    bool found = false;
+
+    std::string line;
+    while (std::getline(is, line))
+    {
+        if (line.size() && line[0] == '=')
+        {
+            if (found)
+            {
+                list.push_back(entry);
+                entry = Entry();
+                found = false;
+            }
+            continue;
+        }
+
+        const std::string::size_type colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            continue;
+        }
+
+        std::string::size_type beg = line.find_first_not_of(" \t");
+        std::string::size_type val = colon + 1;
+        if (val < line.size() && line[val] == ' ')
+        {
+            ++val;
+        }
+
+        setEntry
+        (
+            entry,
+            line.substr(beg, colon - beg),
+            lsfutil::LsfCore::unescape(line.substr(val)),
+            ctx
+        );
+        found = true;
+    }
+
+    if (found)
+    {
+        list.push_back(entry);
+    }
+
+    return true;
+}
+
+
+template<class Entry>
+static bool readRecords(const std::string& file, std::vector<Entry>& list)
+{
+    NoContext ctx;
+    return readRecords(file, list, ctx);
+}
+
+
+template<class Entry>
+static bool writeRecords(const std::string& file, const std::vector<Entry>& list)
+{
+    std::ofstream os(file.c_str());
+
+    os  << separator_;
+    for
+    (
+        typename std::vector<Entry>::const_iterator iter = list.begin();
+        iter != list.end();
+        ++iter
+    )
+    {
+        iter->dump(os);
+        os  << separator_;
+    }
+
+    return os.good();
+}
+
+static bool writeRecords
+(
+    const std::string& file,
+    const std::vector<lsfutil::LsfJobEntry>& list,
+    const lsfutil::LsfStringPool& pool
+)
+{
+    std::ofstream os(file.c_str());
+
+    os  << separator_;
+    for (unsigned jobI = 0; jobI < list.size(); ++jobI)
+    {
+        list[jobI].dump(os, pool);
+        os  << separator_;
+    }
+
+    return os.good();
+}
+
+//! \endcond
+
+
+// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+
+bool lsfutil::LsfReplaySource::record
+(
+    const std::string& dir,
+    LsfDataSource& src
+)
+{
+    std::vector<LsfJobEntry> jobs;
+    LsfStringPool pool;
+    std::vector<LsfHostEntry> hosts;
+    std::vector<LsfQueueEntry> queues;
+    std::vector<LsfHostGroupEntry> groups;
+
+    bool ok = src.fetchJobs(jobs, pool, true);
+    ok = src.fetchHosts(hosts) && ok;
+    ok = src.fetchQueues(queues) && ok;
+    ok = src.fetchHostGroups(groups) && ok;
+
+    ok = ok && writeRecords(dir + "/jobs.new", jobs, pool);
+    ok = ok && writeRecords(dir + "/hosts.new", hosts);
+    ok = ok && writeRecords(dir + "/queues.new", queues);
+    ok = ok && writeRecords(dir + "/hostgroups.new", groups);
+
+    // replace each file in one step, so that a concurrent reader sees
+    // either the old or the new one, but never a partial file
+    for (unsigned fileI = 0; fileI < nFiles_; ++fileI)
+    {
+        const std::string file = dir + "/" + files_[fileI];
+
+        if (ok)
+        {
+            ok = !::rename((file + ".new").c_str(), file.c_str());
+        }
+        else
+        {
+            ::remove((file + ".new").c_str());
+        }
+    }
+
+    return ok;
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfReplaySource::LsfReplaySource(const std::string& dir)
+:
+    LsfDataSource(),
+    dir_(dir)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfReplaySource::~LsfReplaySource()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+std::string lsfutil::LsfReplaySource::name() const
+{
+    return "replay " + dir_;
+}
+
+
+bool lsfutil::LsfReplaySource::fetchJobs
+(
+    std::vector<LsfJobEntry>& list,
+    LsfStringPool& pool,
+    bool withPending
+)
+{
+    if (withPending)
+    {
+        return readRecords(dir_ + "/jobs", list, pool);
+    }
+
+    std::vector<LsfJobEntry> all;
+    if (!readRecords(dir_ + "/jobs", all, pool))
+    {
+        return false;
+    }
+
+    for
+    (
+        std::vector<LsfJobEntry>::const_iterator iter = all.begin();
+        iter != all.end();
+        ++iter
+    )
+    {
+        if (!iter->isPending())
+        {
+            list.push_back(*iter);
+        }
+    }
+
+    return true;
+}
+
+
+bool lsfutil::LsfReplaySource::fetchHosts(std::vector<LsfHostEntry>& list)
+{
+    return readRecords(dir_ + "/hosts", list);
+}
+
+
+bool lsfutil::LsfReplaySource::fetchQueues(std::vector<LsfQueueEntry>& list)
+{
+    return readRecords(dir_ + "/queues", list);
+}
+
+
+bool lsfutil::LsfReplaySource::fetchHostGroups
+(
+    std::vector<LsfHostGroupEntry>& list
+)
+{
+    const std::string file = dir_ + "/hostgroups";
+
+    // recordings made before host groups were recorded have none
+    if (!std::ifstream(file.c_str()))
+    {
+        return true;
+    }
+
+    return readRecords(file, list);
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,126 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfReplaySource
+
+Description
+    Replay job, host and queue information that was previously recorded
+    to files, which allows the rendering and the http server to be
+    exercised without an LSF installation.
+
+    The recording directory contains the files \c jobs, \c hosts,
+    \c queues and \c hostgroups, in the same text format as written by
+    the respective dump() methods: "key: value" lines, with records
+    separated by a line of '=' characters. The files are re-read for each
+    fetch, so they can be replaced while a server is running, as done by
+    record().
+    The \c hostgroups file is optional.
+
+SourceFiles
+    LsfReplaySource.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_REPLAY_SOURCE_H
+#define LSF_REPLAY_SOURCE_H
+
+#include "lsfutil/LsfDataSource.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class LsfReplaySource Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfReplaySource
+:
+    public LsfDataSource
+{
+    // Private data
+
+        //- The recording directory
+        std::string dir_;
+
+
+public:
+
+    // Static Member Functions
+
+        //- Record the current contents of a data source into a directory.
+        //  The files are only replaced if all of them could be fetched
+        //  and written, each one atomically.
+        //  \return false if the source had errors or the files could
+        //  not be written
+        static bool record(const std::string& dir, LsfDataSource&);
+
+
+    // Constructors
+
+        //- Construct for the given recording directory
+        explicit LsfReplaySource(const std::string& dir);
+
+
+    //- Destructor
+    virtual ~LsfReplaySource();
+
+
+    // Member Functions
+
+        //- The recording directory
+        const std::string& dir() const
+        {
+            return dir_;
+        }
+
+        //- Short description of the source
+        virtual std::string name() const;
+
+        //- Append the recorded (running and optionally pending) jobs
+        virtual bool fetchJobs
+        (
+            std::vector<LsfJobEntry>&,
+            LsfStringPool&,
+            bool withPending
+        );
+
+        //- Append the recorded hosts
+        virtual bool fetchHosts(std::vector<LsfHostEntry>&);
+
+        //- Append the recorded queues
+        virtual bool fetchQueues(std::vector<LsfQueueEntry>&);
+
+        //- Append the recorded host groups, if any
+        virtual bool fetchHostGroups(std::vector<LsfHostGroupEntry>&);
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_REPLAY_SOURCE_H
+
+// ************************************************************************* //
@@ -0,0 +1,255 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfRusage.hpp"
+
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+
+
+//! \cond local scope
+
+// order by alternative and then by name
+class RequestLess
+{
+    const lsfutil::LsfStringPool& pool_;
+
+    // the names are nul-terminated text
+    bool less(unsigned a, unsigned b) const
+    {
+        return strcmp(pool_[a].c_str(), pool_[b].c_str()) < 0;
+    }
+
+public:
+
+    explicit RequestLess(const lsfutil::LsfStringPool& pool)
+    :
+        pool_(pool)
+    {}
+
+    bool operator()
+    (
+        const lsfutil::LsfRusage::Request& a,
+        const lsfutil::LsfRusage::Request& b
+    ) const
+    {
+        return
+        (
+            a.alternative < b.alternative
+         || (a.alternative == b.alternative && less(a.name, b.name))
+        );
+    }
+};
+
+
+// the same resource of the same alternative
+static bool requestSame
+(
+    const lsfutil::LsfRusage::Request& a,
+    const lsfutil::LsfRusage::Request& b
+)
+{
+    // interned, so comparing ids suffices
+    return a.alternative == b.alternative && a.name == b.name;
+}
+
+
+// the range [beg,end) without surrounding whitespace
+static void trim
+(
+    const std::string& str,
+    std::string::size_type& beg,
+    std::string::size_type& end
+)
+{
+    while (beg < end && isspace(static_cast<unsigned char>(str[beg])))
+    {
+        ++beg;
+    }
+    while (end > beg && isspace(static_cast<unsigned char>(str[end-1])))
+    {
+        --end;
+    }
+}
+
+//! \endcond
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void lsfutil::LsfRusage::parseSection
+(
+    const std::string& resReq,
+    std::string::size_type beg,
+    std::string::size_type end,
+    std::vector<Request>& requests,
+    LsfStringPool& pool
+)
+{
+    unsigned alternative = 0;
+
+    while (beg < end)
+    {
+        std::string::size_type sep = resReq.find_first_of(",:|", beg);
+        if (sep == std::string::npos || sep > end)
+        {
+            sep = end;
+        }
+
+        const std::string::size_type equals = resReq.find('=', beg);
+        if (equals < sep)
+        {
+            std::string::size_type nameBeg = beg, nameEnd = equals;
+            std::string::size_type valBeg = equals + 1, valEnd = sep;
+            trim(resReq, nameBeg, nameEnd);
+            trim(resReq, valBeg, valEnd);
+
+            const std::string name
+            (
+                resReq, nameBeg, nameEnd - nameBeg
+            );
+
+            // modifiers of the preceding resources
+            if (name.size() && name != "duration" && name != "decay")
+            {
+                Request req;
+                req.name = pool.intern(name);
+                req.value = pool.intern
+                (
+                    std::string(resReq, valBeg, valEnd - valBeg)
+                );
+                req.alternative = alternative;
+
+                requests.push_back(req);
+            }
+        }
+
+        if (sep < end && resReq[sep] == '|')
+        {
+            ++alternative;
+            if (sep + 1 < end && resReq[sep + 1] == '|')
+            {
+                ++sep;
+            }
+        }
+
+        beg = sep + 1;
+    }
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfRusage::LsfRusage()
+:
+    requests_()
+{}
+
+
+lsfutil::LsfRusage::LsfRusage
+(
+    const std::string& resReq,
+    LsfStringPool& pool
+)
+:
+    requests_()
+{
+    parse(resReq, pool);
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+bool lsfutil::LsfRusage::contains
+(
+    const std::string& name,
+    const LsfStringPool& pool
+) const
+{
+    const unsigned id = pool.find(name);
+
+    for (const_iterator iter = begin(); iter != end(); ++iter)
+    {
+        if (iter->name == id)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void lsfutil::LsfRusage::parse
+(
+    const std::string& resReq,
+    LsfStringPool& pool
+)
+{
+    std::vector<Request> requests;
+
+    static const std::string mark = "rusage[";
+
+    std::string::size_type beg = resReq.find(mark);
+    while (beg != std::string::npos)
+    {
+        beg += mark.size();
+
+        std::string::size_type end = resReq.find(']', beg);
+        if (end == std::string::npos)
+        {
+            end = resReq.size();
+        }
+
+        parseSection(resReq, beg, end, requests, pool);
+
+        beg = resReq.find(mark, end);
+    }
+
+    if (requests.size() > 1)
+    {
+        // sort, keeping the last value of any resource named more than once
+        std::stable_sort(requests.begin(), requests.end(), RequestLess(pool));
+
+        std::vector<Request>::iterator out = requests.begin();
+        for
+        (
+            std::vector<Request>::iterator iter = requests.begin();
+            iter != requests.end();
+            ++iter
+        )
+        {
+            if (iter + 1 != requests.end() && requestSame(*iter, *(iter + 1)))
+            {
+                continue;
+            }
+            *out++ = *iter;
+        }
+
+        requests.erase(out, requests.end());
+    }
+
+    requests_ = pool.store(requests);
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,171 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfRusage
+
+Description
+    The resource usage (rusage) requests of a job, parsed once from its
+    resource requirement string.
+
+    This covers the full rusage[] grammar:
+    \verbatim
+    rusage[lic=1:duration=5,mem=4000:swp=100] rusage[tmp=50]
+    rusage[mem=20000:duration=1h || mem=10000:duration=2h]
+    \endverbatim
+    Resources are separated by ',' or ':', and the duration and decay
+    modifiers are skipped. The alternatives separated by '||' are numbered
+    from 0 (the preferred one), and all rusage[] sections are merged.
+    Within each alternative, the requests are sorted by resource name and
+    a resource named more than once keeps its last value.
+
+    The names and values are interned into the string pool of the job
+    list, and the list of ids is stored in the same pool, so that all of
+    it is released together with the snapshot.
+
+SourceFiles
+    LsfRusage.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_RUSAGE_H
+#define LSF_RUSAGE_H
+
+#include <string>
+#include <vector>
+
+#include "lsfutil/LsfStringPool.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                         Class LsfRusage Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfRusage
+{
+public:
+
+    //- A resource request
+    struct Request
+    {
+        //- The resource name (pool id)
+        unsigned name;
+
+        //- The requested value (pool id)
+        unsigned value;
+
+        //- The alternative that the request belongs to, 0 = preferred
+        unsigned alternative;
+    };
+
+    typedef LsfSpan<Request>::const_iterator const_iterator;
+
+
+private:
+
+    // Private data
+
+        //- The requests, by alternative and then by name,
+        //  stored in the pool
+        LsfSpan<Request> requests_;
+
+
+    // Private Member Functions
+
+        //- Add the requests of one rusage[] section
+        static void parseSection
+        (
+            const std::string& resReq,
+            std::string::size_type beg,
+            std::string::size_type end,
+            std::vector<Request>& requests,
+            LsfStringPool& pool
+        );
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        LsfRusage();
+
+        //- Construct by parsing a resource requirement string,
+        //  interning the names and values into the pool
+        LsfRusage(const std::string& resReq, LsfStringPool& pool);
+
+
+    // Member Functions
+
+        // Access
+
+            //- No requests?
+            bool empty() const
+            {
+                return requests_.empty();
+            }
+
+            //- The number of requests, in all alternatives
+            unsigned size() const
+            {
+                return requests_.size();
+            }
+
+            //- The first request
+            const_iterator begin() const
+            {
+                return requests_.begin();
+            }
+
+            //- The end of the requests
+            const_iterator end() const
+            {
+                return requests_.end();
+            }
+
+            //- Is the resource requested in any alternative?
+            bool contains
+            (
+                const std::string& name,
+                const LsfStringPool& pool
+            ) const;
+
+
+        // Edit
+
+            //- Parse a resource requirement string, replacing the requests,
+            //  and intern the names and values into the pool
+            void parse(const std::string& resReq, LsfStringPool& pool);
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_RUSAGE_H
+
+// ************************************************************************* //
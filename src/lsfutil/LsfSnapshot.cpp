@@ -0,0 +1,55 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfSnapshot.hpp"
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfSnapshot::LsfSnapshot(unsigned long generation)
+:
+    markutil::RefCount(),
+    updated_(time(0)),
+    generation_(generation),
+    jobs_(),
+    hosts_(),
+    arena_(),
+    hostJobs_(hosts_, jobs_, arena_),
+    jobColumns_(jobs_, arena_)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfSnapshot::~LsfSnapshot()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+unsigned lsfutil::LsfSnapshot::age() const
+{
+    const time_t now = time(0);
+    return (now > updated_ ? now - updated_ : 0);
+}
+
+
+/* ************************************************************************* */
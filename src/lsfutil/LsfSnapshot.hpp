@@ -0,0 +1,164 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfSnapshot
+
+Description
+    An immutable snapshot of the LSF jobs and hosts, taken at one point
+    in time. Snapshots are reference-counted and are shared between all
+    readers via lsfutil::LsfSnapshot::Ptr.
+
+    The job slots on each host are indexed once when the snapshot is
+    taken (lsfutil::LsfHostJobIndex), as are the columns of the jobs that
+    are filtered on (lsfutil::LsfJobColumns).
+
+SourceFiles
+    LsfSnapshot.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_SNAPSHOT_H
+#define LSF_SNAPSHOT_H
+
+#include <ctime>
+
+#include "markutil/RefPtr.hpp"
+#include "lsfutil/LsfJobList.hpp"
+#include "lsfutil/LsfHostList.hpp"
+#include "lsfutil/LsfHostJobIndex.hpp"
+#include "lsfutil/LsfJobColumns.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                         Class LsfSnapshot Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfSnapshot
+:
+    public markutil::RefCount
+{
+    // Private data
+
+        //- The time the snapshot was taken
+        time_t updated_;
+
+        //- The snapshot generation, increases with each snapshot taken
+        unsigned long generation_;
+
+        //- The jobs
+        LsfJobList jobs_;
+
+        //- The hosts
+        LsfHostList hosts_;
+
+        //- The arena of the index and the columns
+        LsfArena arena_;
+
+        //- The job slots on each host
+        LsfHostJobIndex hostJobs_;
+
+        //- The job columns
+        LsfJobColumns jobColumns_;
+
+
+public:
+
+    //- Shared read-only pointer to a snapshot
+    typedef markutil::RefPtr<const LsfSnapshot> Ptr;
+
+
+    // Constructors
+
+        //- Construct by fetching the current jobs and hosts
+        explicit LsfSnapshot(unsigned long generation);
+
+
+    //- Destructor
+    ~LsfSnapshot();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The time the snapshot was taken
+            time_t updated() const
+            {
+                return updated_;
+            }
+
+            //- The age of the snapshot (seconds)
+            unsigned age() const;
+
+            //- The snapshot generation
+            unsigned long generation() const
+            {
+                return generation_;
+            }
+
+            //- The jobs
+            const LsfJobList& jobs() const
+            {
+                return jobs_;
+            }
+
+            //- The hosts
+            const LsfHostList& hosts() const
+            {
+                return hosts_;
+            }
+
+            //- The job slots on each host
+            const LsfHostJobIndex& hostJobs() const
+            {
+                return hostJobs_;
+            }
+
+            //- The job columns
+            const LsfJobColumns& jobColumns() const
+            {
+                return jobColumns_;
+            }
+
+
+        // Check
+
+            //- Any errors encountered when fetching?
+            bool hasError() const
+            {
+                return jobs_.hasError() || hosts_.hasError();
+            }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_SNAPSHOT_H
+
+// ************************************************************************* //
@@ -0,0 +1,418 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfSnapshotCache.hpp"
+
+#include <vector>
+#include <algorithm>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+unsigned lsfutil::LsfSnapshotCache::defaultInterval = 10;
+unsigned lsfutil::LsfSnapshotCache::defaultMaxStale = 600;
+
+
+//! \cond local scope
+
+// started caches, which need their mutex handled across a fork()
+static std::vector<lsfutil::LsfSnapshotCache*> registry_;
+static markutil::Mutex registryMutex_;
+static pthread_once_t registryOnce_ = PTHREAD_ONCE_INIT;
+
+//! \endcond
+
+
+// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+
+void* lsfutil::LsfSnapshotCache::refresher(void* arg)
+{
+    static_cast<LsfSnapshotCache*>(arg)->loop();
+    return NULL;
+}
+
+
+void* lsfutil::LsfSnapshotCache::revalidator(void* arg)
+{
+    static_cast<LsfSnapshotCache*>(arg)->update();
+    return NULL;
+}
+
+
+// a fork() while the refresher holds the mutex would leave it locked
+// forever in the child, so hold all of them across the fork
+void lsfutil::LsfSnapshotCache::forkPrepare()
+{
+    registryMutex_.lock();
+    for (unsigned i = 0; i < registry_.size(); ++i)
+    {
+        registry_[i]->mutex_.lock();
+    }
+}
+
+
+void lsfutil::LsfSnapshotCache::forkParent()
+{
+    for (unsigned i = 0; i < registry_.size(); ++i)
+    {
+        registry_[i]->mutex_.unlock();
+    }
+    registryMutex_.unlock();
+}
+
+
+void lsfutil::LsfSnapshotCache::forkChild()
+{
+    // the refresher thread does not exist in the child, but the parent
+    // still refreshes in the background, so retain background_.
+    // Any snapshot in progress will never complete in the child.
+    for (unsigned i = 0; i < registry_.size(); ++i)
+    {
+        registry_[i]->running_ = false;
+        registry_[i]->fetching_ = false;
+        registry_[i]->mutex_.unlock();
+    }
+    registry_.clear();
+    registryMutex_.unlock();
+}
+
+
+void lsfutil::LsfSnapshotCache::registerForkHandlers()
+{
+    ::pthread_atfork(forkPrepare, forkParent, forkChild);
+}
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void lsfutil::LsfSnapshotCache::loop()
+{
+    while (true)
+    {
+        {
+            markutil::Mutex::Lock lock(mutex_);
+            if (!running_)
+            {
+                break;
+            }
+
+            wakeup_.wait(mutex_, interval_);
+
+            if (!running_)
+            {
+                break;
+            }
+        }
+
+        this->update();
+    }
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfSnapshotCache::LsfSnapshotCache(unsigned interval)
+:
+    mutex_(),
+    wakeup_(),
+    fetched_(),
+    current_(),
+    interval_(interval ? interval : 1),
+    maxStale_(defaultMaxStale),
+    generation_(0),
+    fetching_(false),
+    fetchOk_(false),
+    coalesced_(0),
+    failedAt_(0),
+    failures_(0),
+    thread_(),
+    running_(false),
+    background_(false)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+lsfutil::LsfSnapshotCache::~LsfSnapshotCache()
+{
+    this->stop();
+
+    // a background update may still be in progress
+    markutil::Mutex::Lock lock(mutex_);
+    while (fetching_)
+    {
+        fetched_.wait(mutex_);
+    }
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+lsfutil::LsfSnapshot::Ptr lsfutil::LsfSnapshotCache::snapshot()
+{
+    bool stale;
+    return this->snapshot(stale);
+}
+
+
+lsfutil::LsfSnapshot::Ptr lsfutil::LsfSnapshotCache::snapshot(bool& stale)
+{
+    bool wait = true;
+    {
+        markutil::Mutex::Lock lock(mutex_);
+        if (current_.valid())
+        {
+            const unsigned age = current_->age();
+
+            if (background_ || age < interval_)
+            {
+                wait = false;
+            }
+            else if (!maxStale_ || age <= maxStale_)
+            {
+                // serve the old snapshot while updating in the background,
+                // but leave LSF alone for an interval after a failure
+                wait = false;
+
+                const bool retry =
+                (
+                    !fetching_
+                 && time(0) >= failedAt_ + time_t(interval_)
+                );
+
+                if (retry)
+                {
+                    pthread_t thread;
+                    pthread_attr_t attr;
+                    ::pthread_attr_init(&attr);
+                    ::pthread_attr_setdetachstate
+                    (
+                        &attr,
+                        PTHREAD_CREATE_DETACHED
+                    );
+
+                    if (::pthread_create(&thread, &attr, revalidator, this))
+                    {
+                        wait = true;
+                    }
+
+                    ::pthread_attr_destroy(&attr);
+                }
+            }
+        }
+    }
+
+    if (wait)
+    {
+        this->update();
+    }
+
+    markutil::Mutex::Lock lock(mutex_);
+
+    LsfSnapshot::Ptr snap(current_);
+    stale = false;
+
+    if (snap.valid())
+    {
+        const unsigned age = snap->age();
+
+        if (maxStale_ && age > maxStale_)
+        {
+            snap.reset();
+        }
+        else
+        {
+            // the background refresher only becomes overdue after
+            // it has had a full interval to take the snapshot
+            stale =
+            (
+                failedAt_
+             || age >= (background_ ? 2*interval_ : interval_)
+            );
+        }
+    }
+
+    return snap;
+}
+
+
+lsfutil::LsfSnapshot::Ptr lsfutil::LsfSnapshotCache::waitNewer
+(
+    unsigned long generation,
+    unsigned seconds
+)
+{
+    markutil::Mutex::Lock lock(mutex_);
+
+    while
+    (
+        running_
+     && (!current_.valid() || current_->generation() <= generation)
+    )
+    {
+        if (!fetched_.wait(mutex_, seconds))
+        {
+            return LsfSnapshot::Ptr();
+        }
+    }
+
+    if (!running_)
+    {
+        return LsfSnapshot::Ptr();
+    }
+
+    return current_;
+}
+
+
+void lsfutil::LsfSnapshotCache::interval(unsigned val)
+{
+    markutil::Mutex::Lock lock(mutex_);
+    interval_ = val ? val : 1;
+}
+
+
+void lsfutil::LsfSnapshotCache::maxStale(unsigned val)
+{
+    markutil::Mutex::Lock lock(mutex_);
+    maxStale_ = val;
+}
+
+
+bool lsfutil::LsfSnapshotCache::update()
+{
+    unsigned long gen;
+    {
+        markutil::Mutex::Lock lock(mutex_);
+
+        if (fetching_)
+        {
+            // share the result of the snapshot in progress
+            ++coalesced_;
+
+            const unsigned long inProgress = generation_;
+            while (fetching_ && generation_ == inProgress)
+            {
+                fetched_.wait(mutex_);
+            }
+
+            return fetchOk_;
+        }
+
+        fetching_ = true;
+        gen = ++generation_;
+    }
+
+    // fetch without holding the lock - this is the slow part
+    LsfSnapshot::Ptr snap(new LsfSnapshot(gen));
+
+    markutil::Mutex::Lock lock(mutex_);
+
+    fetching_ = false;
+    fetchOk_ = !snap->hasError();
+
+    if (fetchOk_)
+    {
+        failedAt_ = 0;
+    }
+    else
+    {
+        failedAt_ = snap->updated();
+        ++failures_;
+    }
+
+    // never replace a newer snapshot, nor a good one with errors
+    if
+    (
+        !current_.valid()
+     || (
+            current_->generation() < gen
+         && (fetchOk_ || current_->hasError())
+        )
+    )
+    {
+        current_ = snap;
+    }
+
+    fetched_.broadcast();
+
+    return fetchOk_;
+}
+
+
+bool lsfutil::LsfSnapshotCache::start()
+{
+    {
+        markutil::Mutex::Lock lock(mutex_);
+        if (running_)
+        {
+            return true;
+        }
+    }
+
+    this->update();
+
+    ::pthread_once(&registryOnce_, registerForkHandlers);
+
+    markutil::Mutex::Lock regLock(registryMutex_);
+    markutil::Mutex::Lock lock(mutex_);
+
+    running_ = true;
+    if (::pthread_create(&thread_, NULL, refresher, this) != 0)
+    {
+        running_ = false;
+        return false;
+    }
+
+    background_ = true;
+    registry_.push_back(this);
+
+    return true;
+}
+
+
+void lsfutil::LsfSnapshotCache::stop()
+{
+    {
+        markutil::Mutex::Lock regLock(registryMutex_);
+        markutil::Mutex::Lock lock(mutex_);
+        if (!running_)
+        {
+            return;
+        }
+
+        running_ = false;
+        background_ = false;
+        wakeup_.signal();
+        fetched_.broadcast();
+
+        registry_.erase
+        (
+            std::remove(registry_.begin(), registry_.end(), this),
+            registry_.end()
+        );
+    }
+
+    ::pthread_join(thread_, NULL);
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,259 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfSnapshotCache
+
+Description
+    Holds the most recent lsfutil::LsfSnapshot for the whole process.
+
+    When started, a background thread takes a new snapshot every
+    interval() seconds and swaps it in. Readers simply take a reference
+    to the current snapshot, which remains valid for as long as they hold
+    it, even if a newer snapshot has been swapped in meanwhile.
+
+    Without the background thread, a snapshot older than interval()
+    seconds triggers a new snapshot in the background, while the old one
+    continues to be served (stale-while-revalidate). Only when there is
+    no snapshot or it is older than maxStale() seconds do the readers
+    wait for the new snapshot.
+
+    A snapshot with errors never replaces a good one, so the last good
+    snapshot is served while LSF is unavailable, but only up to
+    maxStale() seconds old.
+
+    At most one snapshot is taken at any time: any update requested while
+    a snapshot is being taken simply waits for that one to complete and
+    shares its result (single-flight). The number of requests coalesced
+    in this manner is available as coalesced().
+
+    Since the LSF library is thus never called concurrently, it does not
+    need to be thread-safe itself.
+
+    Consumers of each new snapshot (eg, to pre-render responses) can wait
+    for it to be swapped in with waitNewer().
+
+SourceFiles
+    LsfSnapshotCache.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_SNAPSHOT_CACHE_H
+#define LSF_SNAPSHOT_CACHE_H
+
+#include <pthread.h>
+
+#include "markutil/Mutex.hpp"
+#include "lsfutil/LsfSnapshot.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                      Class LsfSnapshotCache Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfSnapshotCache
+{
+    // Private data
+
+        //- Protects all of the following
+        markutil::Mutex mutex_;
+
+        //- Wake the refresher thread
+        markutil::Condition wakeup_;
+
+        //- Signalled when a snapshot has been taken
+        markutil::Condition fetched_;
+
+        //- The current snapshot
+        LsfSnapshot::Ptr current_;
+
+        //- The refresh interval (seconds)
+        unsigned interval_;
+
+        //- The maximum age (seconds) of a snapshot to be served, 0 = any
+        unsigned maxStale_;
+
+        //- The most recently issued generation
+        unsigned long generation_;
+
+        //- A snapshot is currently being taken
+        bool fetching_;
+
+        //- The snapshot taken most recently was without errors
+        bool fetchOk_;
+
+        //- The number of updates that waited for a snapshot in progress
+        unsigned long coalesced_;
+
+        //- The time of the most recent failed attempt, 0 after success
+        time_t failedAt_;
+
+        //- The number of failed attempts
+        unsigned long failures_;
+
+        //- The refresher thread
+        pthread_t thread_;
+
+        //- The refresher thread is running
+        bool running_;
+
+        //- Refreshing is done in the background (possibly by our parent)
+        bool background_;
+
+
+    // Private Member Functions
+
+        //- Entry point for the refresher thread
+        static void* refresher(void*);
+
+        //- Entry point for a one-off background update
+        static void* revalidator(void*);
+
+        //- The refresher loop
+        void loop();
+
+        //- Fork handlers to avoid inheriting a locked mutex
+        static void forkPrepare();
+        static void forkParent();
+        static void forkChild();
+
+        //- Register the fork handlers (once)
+        static void registerForkHandlers();
+
+        //- Disallow default bitwise copy construct
+        LsfSnapshotCache(const LsfSnapshotCache&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const LsfSnapshotCache&);
+
+
+public:
+
+    // Static data members
+
+        //- The default refresh interval (seconds)
+        static unsigned defaultInterval;
+
+        //- The default maximum age (seconds) of a snapshot to be served
+        static unsigned defaultMaxStale;
+
+
+    // Constructors
+
+        //- Construct with a given refresh interval, without a snapshot
+        explicit LsfSnapshotCache(unsigned interval = defaultInterval);
+
+
+    //- Destructor, stops the refresher thread and waits for any update
+    ~LsfSnapshotCache();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The refresh interval (seconds)
+            unsigned interval() const
+            {
+                return interval_;
+            }
+
+            //- The maximum age (seconds) of a snapshot to be served
+            unsigned maxStale() const
+            {
+                return maxStale_;
+            }
+
+            //- The time of the most recent failed update, 0 if it succeeded
+            time_t failedAt() const
+            {
+                return failedAt_;
+            }
+
+            //- The number of failed updates
+            unsigned long failures() const
+            {
+                return failures_;
+            }
+
+            //- The number of updates that were coalesced with
+            //  a snapshot already in progress
+            unsigned long coalesced() const
+            {
+                return coalesced_;
+            }
+
+            //- The current snapshot, taking one first if required.
+            //  Invalid if there is no snapshot within maxStale()
+            LsfSnapshot::Ptr snapshot();
+
+            //- The current snapshot, taking one first if required,
+            //  and whether it is stale: the most recent update failed or
+            //  it is overdue for replacement.
+            //  Invalid if there is no snapshot within maxStale()
+            LsfSnapshot::Ptr snapshot(bool& stale);
+
+            //- Wait for a snapshot newer than the given generation to be
+            //  swapped in, for at most the given number of seconds.
+            //  Invalid if the wait timed out or the refresher was stopped
+            LsfSnapshot::Ptr waitNewer
+            (
+                unsigned long generation,
+                unsigned seconds
+            );
+
+
+        // Edit
+
+            //- Set the refresh interval (seconds), minimum 1
+            void interval(unsigned);
+
+            //- Set the maximum age (seconds) of a snapshot to be served,
+            //  0 for no limit
+            void maxStale(unsigned);
+
+            //- Take a new snapshot immediately and make it current unless
+            //  it has errors and there is already a good one,
+            //  or wait for the snapshot that is already in progress
+            //  \return true if the new snapshot is without errors
+            bool update();
+
+            //- Take an initial snapshot and start the refresher thread
+            //  \return true if the thread is running
+            bool start();
+
+            //- Stop the refresher thread
+            void stop();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_SNAPSHOT_CACHE_H
+
+// ************************************************************************* //
@@ -0,0 +1,131 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfSpan
+
+Description
+    A read-only reference to an array of plain data held elsewhere,
+    normally in the lsfutil::LsfArena of a snapshot.
+
+    Like lsfutil::LsfText, copying the reference is cheap, but it is only
+    valid for as long as the memory it refers to.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_SPAN_H
+#define LSF_SPAN_H
+
+#include <cstddef>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                          Class LsfSpan Declaration
+\*---------------------------------------------------------------------------*/
+
+template<class T>
+class LsfSpan
+{
+    // Private data
+
+        //- The items
+        const T* data_;
+
+        //- The number of items
+        unsigned size_;
+
+
+public:
+
+    typedef const T* const_iterator;
+
+
+    // Constructors
+
+        //- Construct empty
+        LsfSpan()
+        :
+            data_(NULL),
+            size_(0)
+        {}
+
+        //- Construct from the given items, which must outlive the span
+        LsfSpan(const T* data, unsigned len)
+        :
+            data_(data),
+            size_(len)
+        {}
+
+
+    // Member Functions
+
+        // Access
+
+            //- The items
+            const T* data() const
+            {
+                return data_;
+            }
+
+            //- The number of items
+            unsigned size() const
+            {
+                return size_;
+            }
+
+            //- True if there are no items
+            bool empty() const
+            {
+                return !size_;
+            }
+
+            //- The item at the given position
+            const T& operator[](unsigned i) const
+            {
+                return data_[i];
+            }
+
+            //- The first item
+            const_iterator begin() const
+            {
+                return data_;
+            }
+
+            //- The end of the items
+            const_iterator end() const
+            {
+                return data_ + size_;
+            }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_SPAN_H
+
+// ************************************************************************* //
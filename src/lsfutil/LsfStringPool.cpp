@@ -0,0 +1,167 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/LsfStringPool.hpp"
+
+#include <cstring>
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+unsigned lsfutil::LsfStringPool::hash(const char* str, size_t len)
+{
+    // FNV-1a
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < len; ++i)
+    {
+        h = (h ^ static_cast<unsigned char>(str[i])) * 16777619u;
+    }
+
+    return h;
+}
+
+
+unsigned lsfutil::LsfStringPool::slot(const char* str, size_t len) const
+{
+    const unsigned mask = table_.size() - 1;
+
+    // linear probing, the table is never full
+    unsigned slotI = hash(str, len) & mask;
+    while (table_[slotI])
+    {
+        const LsfText& text = strings_[table_[slotI] - 1];
+
+        if (text.size() == len && !memcmp(text.data(), str, len))
+        {
+            break;
+        }
+
+        slotI = (slotI + 1) & mask;
+    }
+
+    return slotI;
+}
+
+
+void lsfutil::LsfStringPool::grow()
+{
+    std::vector<unsigned> table(table_.empty() ? 64 : 2*table_.size(), 0);
+    table_.swap(table);
+
+    for (unsigned id = 0; id < strings_.size(); ++id)
+    {
+        const LsfText& text = strings_[id];
+        table_[slot(text.data(), text.size())] = id + 1;
+    }
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::LsfStringPool::LsfStringPool()
+:
+    strings_(),
+    table_(),
+    arena_()
+{
+    clear();
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+unsigned lsfutil::LsfStringPool::find(const std::string& str) const
+{
+    const unsigned id = table_[slot(str.data(), str.size())];
+
+    return (id ? id - 1 : size());
+}
+
+
+unsigned lsfutil::LsfStringPool::intern(const std::string& str)
+{
+    return intern(str.data(), str.size());
+}
+
+
+unsigned lsfutil::LsfStringPool::intern(const char* str)
+{
+    if (!str || !*str)
+    {
+        return 0;
+    }
+
+    return intern(str, strlen(str));
+}
+
+
+unsigned lsfutil::LsfStringPool::intern(const char* str, size_t len)
+{
+    if (2*(strings_.size() + 1) > table_.size())
+    {
+        grow();
+    }
+
+    unsigned& entry = table_[slot(str, len)];
+
+    if (!entry)
+    {
+        strings_.push_back(store(str, len));
+        entry = strings_.size();
+    }
+
+    return entry - 1;
+}
+
+
+lsfutil::LsfText lsfutil::LsfStringPool::store(const char* str, size_t len)
+{
+    if (!len)
+    {
+        return LsfText();
+    }
+
+    return LsfText(arena_.copy(str, len), len);
+}
+
+
+lsfutil::LsfText lsfutil::LsfStringPool::store(const char* str)
+{
+    if (!str)
+    {
+        return LsfText();
+    }
+
+    return store(str, strlen(str));
+}
+
+
+void lsfutil::LsfStringPool::clear()
+{
+    strings_.clear();
+    table_.clear();
+    arena_.clear();
+
+    intern("", 0);
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,172 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfStringPool
+
+Description
+    A dictionary of strings, each identified by a dense integer id.
+
+    Values that repeat for many jobs (users, queues, hosts, projects) are
+    interned into the pool of their job list, so that each job only holds
+    the ids. Ids compare equal if and only if the strings do, and can be
+    used directly as indices for per-string lookup tables.
+
+    The empty string always has id 0.
+
+    The strings are held in the arena of the pool and looked up through
+    an open-addressed hash table of their ids. Other text of the jobs,
+    which rarely repeats, is stored as lsfutil::LsfText in the same arena
+    without being interned, as are the per-job arrays (lsfutil::LsfSpan).
+    All of it is released at once when the pool is cleared or destroyed.
+
+SourceFiles
+    LsfStringPool.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_STRING_POOL_H
+#define LSF_STRING_POOL_H
+
+#include <string>
+#include <vector>
+
+#include "lsfutil/LsfArena.hpp"
+#include "lsfutil/LsfSpan.hpp"
+#include "lsfutil/LsfText.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class LsfStringPool Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfStringPool
+{
+    // Private data
+
+        //- The strings by id, held in the arena
+        std::vector<LsfText> strings_;
+
+        //- The ids plus one by hash, 0 for an empty slot.
+        //  The size is a power of two, and at most half is used
+        std::vector<unsigned> table_;
+
+        //- The stored text
+        LsfArena arena_;
+
+
+    // Private Member Functions
+
+        //- The hash of the characters
+        static unsigned hash(const char*, size_t);
+
+        //- The slot of the table that holds the id of the characters,
+        //  or the empty slot to put it in
+        unsigned slot(const char*, size_t) const;
+
+        //- Double the size of the table
+        void grow();
+
+        //- Disallow default bitwise copy construct
+        LsfStringPool(const LsfStringPool&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const LsfStringPool&);
+
+
+public:
+
+    // Constructors
+
+        //- Construct with only the empty string
+        LsfStringPool();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of strings
+            unsigned size() const
+            {
+                return strings_.size();
+            }
+
+            //- The string with the given id
+            const LsfText& operator[](unsigned id) const
+            {
+                return strings_[id];
+            }
+
+            //- The id of a string, size() if it is not in the pool
+            unsigned find(const std::string&) const;
+
+
+        // Edit
+
+            //- The id of a string, adding it if required
+            unsigned intern(const std::string&);
+
+            //- The id of a string, adding it if required.
+            //  NULL is treated as the empty string
+            unsigned intern(const char*);
+
+            //- The id of the characters, adding them if required
+            unsigned intern(const char*, size_t);
+
+            //- Store a copy of the text, without interning it
+            LsfText store(const char*, size_t);
+
+            //- Store a copy of the text, without interning it
+            LsfText store(const std::string& str)
+            {
+                return store(str.data(), str.size());
+            }
+
+            //- Store a copy of the text, without interning it.
+            //  NULL is treated as the empty string
+            LsfText store(const char*);
+
+            //- Store a copy of the items of plain data
+            template<class T>
+            LsfSpan<T> store(const std::vector<T>& list)
+            {
+                return arena_.copy(list);
+            }
+
+            //- Remove all strings except the empty string,
+            //  and release all stored text and items
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_STRING_POOL_H
+
+// ************************************************************************* //
@@ -0,0 +1,138 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::LsfText
+
+Description
+    A read-only reference to nul-terminated text held elsewhere,
+    normally in the lsfutil::LsfArena of an lsfutil::LsfStringPool.
+
+    Copying the text reference is cheap, but it is only valid for as long
+    as the memory it refers to: the text of a job is valid for as long as
+    the string pool of its job list is not cleared.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_TEXT_H
+#define LSF_TEXT_H
+
+#include <string>
+#include <iostream>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                          Class LsfText Declaration
+\*---------------------------------------------------------------------------*/
+
+class LsfText
+{
+    // Private data
+
+        //- The characters, nul-terminated
+        const char* str_;
+
+        //- The number of characters
+        unsigned size_;
+
+
+public:
+
+    // Constructors
+
+        //- Construct empty
+        LsfText()
+        :
+            str_(""),
+            size_(0)
+        {}
+
+        //- Construct from nul-terminated characters of the given length,
+        //  which must outlive the text
+        LsfText(const char* str, unsigned len)
+        :
+            str_(str),
+            size_(len)
+        {}
+
+
+    // Member Functions
+
+        // Access
+
+            //- The nul-terminated characters
+            const char* c_str() const
+            {
+                return str_;
+            }
+
+            //- The characters
+            const char* data() const
+            {
+                return str_;
+            }
+
+            //- The number of characters
+            unsigned size() const
+            {
+                return size_;
+            }
+
+            //- True if there are no characters
+            bool empty() const
+            {
+                return !size_;
+            }
+
+            //- The character at the given position
+            char operator[](unsigned i) const
+            {
+                return str_[i];
+            }
+
+            //- A copy as a std::string
+            std::string str() const
+            {
+                return std::string(str_, size_);
+            }
+
+
+    // Write
+
+        friend std::ostream& operator<<(std::ostream& os, const LsfText& t)
+        {
+            return os.write(t.str_, t.size_);
+        }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_TEXT_H
+
+// ************************************************************************* //
@@ -0,0 +1,150 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "lsfutil/OutputBuffer.hpp"
+
+#include <cstdio>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+size_t lsfutil::OutputBuffer::defaultCapacity = 4096;
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void lsfutil::OutputBuffer::appendInteger(unsigned long val, bool negative)
+{
+    char buf[24];
+    char* p = buf + sizeof(buf);
+
+    do
+    {
+        *--p = '0' + (val % 10);
+        val /= 10;
+    }
+    while (val);
+
+    if (negative)
+    {
+        *--p = '-';
+    }
+
+    buffer_.append(p, buf + sizeof(buf) - p);
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+lsfutil::OutputBuffer::OutputBuffer(size_t capacity)
+:
+    buffer_()
+{
+    buffer_.reserve(capacity);
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+lsfutil::OutputBuffer& lsfutil::OutputBuffer::escape
+(
+    const char* str,
+    size_t len
+)
+{
+    const char* p = str;
+    const char* const end = p + len;
+
+    while (p != end)
+    {
+        const size_t clean = xml::cleanRun(p, end);
+        if (clean)
+        {
+            buffer_.append(p, clean);
+            p += clean;
+
+            if (p == end)
+            {
+                break;
+            }
+        }
+
+        char ref[xml::entitySize];
+        buffer_.append(ref, xml::entity(*p, ref));
+
+        ++p;
+    }
+
+    return *this;
+}
+
+
+lsfutil::OutputBuffer& lsfutil::OutputBuffer::operator<<
+(
+    const xml::Tag& t
+)
+{
+    (*this) << '<' << t.tag_ << '>' << t.val_;
+    return (*this) << "</" << t.tag_ << '>';
+}
+
+
+lsfutil::OutputBuffer& lsfutil::OutputBuffer::operator<<
+(
+    const xml::TimeTag& tt
+)
+{
+    // as per xml::TimeTag::iso8601(), without the intermediate string
+    char buf[32];
+    struct tm tmval;
+    const size_t len = ::strftime
+    (
+        buf,
+        sizeof(buf),
+        "%Y-%m-%dT%H:%M:%S",
+        ::localtime_r(&tt.epoch_, &tmval)
+    );
+
+    (*this) << '<' << tt.tag_ << " epoch='" << long(tt.epoch_) << "'>";
+    append(buf, len);
+    return (*this) << "</" << tt.tag_ << '>';
+}
+
+
+lsfutil::OutputBuffer& lsfutil::OutputBuffer::fixed(double val, int places)
+{
+    char buf[64];
+    const int len = snprintf(buf, sizeof(buf), "%.*f", places, val);
+
+    return append(buf, len < int(sizeof(buf)) ? len : sizeof(buf) - 1);
+}
+
+
+lsfutil::OutputBuffer& lsfutil::OutputBuffer::operator<<(double val)
+{
+    char buf[64];
+    const int len = snprintf(buf, sizeof(buf), "%g", val);
+
+    return append(buf, len < int(sizeof(buf)) ? len : sizeof(buf) - 1);
+}
+
+
+/* ************************************************************************* */
@@ -0,0 +1,246 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    lsfutil::OutputBuffer
+
+Description
+    A contiguous, growable buffer for rendering output, with appenders
+    for text, integers and floats as well as the lsfutil::xml helpers
+    for escaped text, tags and timestamps, which all format directly
+    into the buffer.
+
+    Unlike an ostream, appending involves neither locale nor sentry
+    overhead, and once the buffer has grown to the size of the output
+    no further allocations are needed. The content can be swapped out
+    without copying.
+
+SourceFiles
+    OutputBuffer.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef LSF_OUTPUT_BUFFER_H
+#define LSF_OUTPUT_BUFFER_H
+
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <iostream>
+
+#include "lsfutil/XmlUtils.hpp"
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace lsfutil
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class OutputBuffer Declaration
+\*---------------------------------------------------------------------------*/
+
+class OutputBuffer
+{
+    // Private data
+
+        //- The content
+        std::string buffer_;
+
+
+    // Private Member Functions
+
+        //- Append an unsigned integer, with a leading '-' if requested
+        void appendInteger(unsigned long val, bool negative);
+
+        //- Disallow default bitwise copy construct
+        OutputBuffer(const OutputBuffer&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const OutputBuffer&);
+
+
+public:
+
+    // Static data members
+
+        //- The default initial capacity
+        static size_t defaultCapacity;
+
+
+    // Constructors
+
+        //- Construct empty, with an initial capacity
+        explicit OutputBuffer(size_t capacity = defaultCapacity);
+
+
+    // Member Functions
+
+        // Access
+
+            //- The content
+            const std::string& str() const
+            {
+                return buffer_;
+            }
+
+            //- The content size
+            size_t size() const
+            {
+                return buffer_.size();
+            }
+
+
+        // Edit
+
+            //- Discard the content, retaining the capacity
+            void clear()
+            {
+                buffer_.clear();
+            }
+
+            //- Exchange the content with the string
+            void swap(std::string& str)
+            {
+                buffer_.swap(str);
+            }
+
+
+        // Append
+
+            //- Append characters verbatim
+            OutputBuffer& append(const char* s, size_t len)
+            {
+                buffer_.append(s, len);
+                return *this;
+            }
+
+            //- Append text with reserved XML characters transliterated
+            OutputBuffer& escape(const char* s, size_t len);
+
+            //- Append text with reserved XML characters transliterated
+            OutputBuffer& escape(const std::string& s)
+            {
+                return escape(s.data(), s.size());
+            }
+
+            //- Append a floating-point value with a fixed number of
+            //  decimal places
+            OutputBuffer& fixed(double val, int places);
+
+
+    // Member Operators
+
+        //- Append characters verbatim
+        OutputBuffer& operator<<(const char* s)
+        {
+            buffer_.append(s, strlen(s));
+            return *this;
+        }
+
+        //- Append characters verbatim
+        OutputBuffer& operator<<(const std::string& s)
+        {
+            buffer_.append(s);
+            return *this;
+        }
+
+        //- Append characters verbatim
+        OutputBuffer& operator<<(const LsfText& s)
+        {
+            buffer_.append(s.data(), s.size());
+            return *this;
+        }
+
+        //- Append a character verbatim
+        OutputBuffer& operator<<(char c)
+        {
+            buffer_ += c;
+            return *this;
+        }
+
+        //- Append an integer
+        OutputBuffer& operator<<(int val)
+        {
+            appendInteger(val < 0 ? -long(val) : val, val < 0);
+            return *this;
+        }
+
+        //- Append an integer
+        OutputBuffer& operator<<(unsigned val)
+        {
+            appendInteger(val, false);
+            return *this;
+        }
+
+        //- Append an integer
+        OutputBuffer& operator<<(long val)
+        {
+            appendInteger
+            (
+                val < 0 ? -static_cast<unsigned long>(val) : val,
+                val < 0
+            );
+            return *this;
+        }
+
+        //- Append an integer
+        OutputBuffer& operator<<(unsigned long val)
+        {
+            appendInteger(val, false);
+            return *this;
+        }
+
+        //- Append a floating-point value, formatted as per an ostream
+        //  with the default precision
+        OutputBuffer& operator<<(double val);
+
+        //- Append text with reserved XML characters transliterated
+        OutputBuffer& operator<<(const xml::String& s)
+        {
+            return escape(s.str_, s.size_);
+        }
+
+        //- Append a tag with the text content transliterated
+        OutputBuffer& operator<<(const xml::Tag&);
+
+        //- Append a tag with the time in ISO-8601 format and the epoch
+        //  as an attribute
+        OutputBuffer& operator<<(const xml::TimeTag&);
+
+
+    // IOstream Operators
+
+        //- Write the content
+        friend std::ostream& operator<<(std::ostream& os, const OutputBuffer& buf)
+        {
+            return os.write(buf.buffer_.data(), buf.buffer_.size());
+        }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace lsfutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // LSF_OUTPUT_BUFFER_H
+
+// ************************************************************************* //
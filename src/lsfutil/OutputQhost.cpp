@@ -21,19 +21,110 @@ License
 
 #include "lsfutil/OutputQhost.hpp"
 #include "lsfutil/XmlUtils.hpp"
-#include <cstdio>
+
+
+//! \cond local scope
+
+// the start of a jobvalue element, up to the value
+static lsfutil::OutputBuffer& jobValue
+(
+    lsfutil::OutputBuffer& os,
+    const lsfutil::LsfJobEntry& job,
+    const char* name
+)
+{
+    os  << lsfutil::xml::indent << "<jobvalue jobid='" << job.jobId;
+    if (job.taskId)
+    {
+        os  << '.' << job.taskId;
+    }
+
+    return os << "' name='" << name << "'>";
+}
+
+
+// the start of a queuevalue element, up to the value
+static lsfutil::OutputBuffer& queueValue
+(
+    lsfutil::OutputBuffer& os,
+    const std::string& queueName,
+    const char* name
+)
+{
+    return os
+        << lsfutil::xml::indent << "<queuevalue qname='" << queueName
+        << "' name='" << name << "'>";
+}
+
+
+// a job element for a slot on the host
+static void jobElement
+(
+    lsfutil::OutputBuffer& os,
+    const lsfutil::LsfJobList& jlist,
+    const lsfutil::LsfJobEntry& job,
+    const std::string& hostName,
+    bool master
+)
+{
+    os  << lsfutil::xml::indent0 << "<job name='" << job.jobId;
+    if (job.taskId)
+    {
+        os  << '.' << job.taskId;
+    }
+    os  << "'>\n";
+
+
+    // queue instance
+    jobValue(os, job, "qinstance_name")
+        << jlist.str(job.submit.queue) << "@" << hostName
+        << "</jobvalue>\n";
+
+    jobValue(os, job, "job_name")
+        << job.submit.jobName
+        << "</jobvalue>\n";
+
+    jobValue(os, job, "job_owner")
+        << jlist.str(job.user)
+        << "</jobvalue>\n";
+
+    jobValue(os, job, "job_state");
+    if (job.isRunning())
+    {
+        os  << "r";
+    }
+    else if (job.isSuspend())
+    {
+        os  << "s";
+    }
+
+    os  << "</jobvalue>\n";
+
+    jobValue(os, job, "start_time")
+        << job.startTime << "</jobvalue>\n";
+
+    jobValue(os, job, "pe_master");
+    os  << (master ? "MASTER" : "SLAVE");
+    os  << "</jobvalue>\n";
+    os  << lsfutil::xml::indent0 << "</job>\n";
+}
+
+//! \endcond
+
 
 // * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQhost::print
 (
-    std::ostream& os,
-    const lsfutil::LsfHostEntry& host,
-    const lsfutil::LsfJobList& jlist
+    OutputBuffer& os,
+    const lsfutil::LsfHostList& list,
+    unsigned hostI,
+    const lsfutil::LsfJobList& jlist,
+    const lsfutil::LsfHostJobIndex& index
 )
 {
-    char buffer[32];
+    const LsfHostEntry& host = list[hostI];
 
     os  << xml::indent0
         << "<host name='"
@@ -67,9 +158,8 @@ lsfutil::OutputQhost::print
 
 
     // max of 3 decimal places
-    snprintf(buffer, sizeof(buffer)-1, "%.3f", host.load_15m);
-    os  << xml::indent << "<hostvalue name='load_avg'>"
-        << buffer
+    os  << xml::indent << "<hostvalue name='load_avg'>";
+    os.fixed(host.load_15m, 3)
         << "</hostvalue>\n";
 
     os  << xml::indent << "<hostvalue name='mem_free'>"
@@ -79,72 +169,38 @@ lsfutil::OutputQhost::print
         << host.free_swp <<  "M</hostvalue>\n";
 
 
-    // count slots used per queue instance
-    std::map<std::string, int> slots_used;
-    for (unsigned queueI = 0; queueI < host.queues.size(); ++queueI)
+    // write job information, once per slot
+    for
+    (
+        LsfHostJobIndex::const_iterator iter = index.begin(hostI);
+        iter != index.end(hostI);
+        ++iter
+    )
     {
-        const std::string& queueName = host.queues[queueI];
-        slots_used[queueName] = 0;
-    }
+        const LsfJobEntry& job = jlist[iter->job];
 
-
-    // write job information and count slots
-    for (unsigned jobI = 0; jobI < jlist.size(); ++jobI)
-    {
-        const LsfJobEntry& job = jlist[jobI];
-        const std::string& queueName = job.submit.queue;
-
-        std::string commonAttr;
-        for (unsigned hostI = 0; hostI < job.execHosts.size(); ++hostI)
+        unsigned slotI = 0;
+        if (!iter->first)
         {
-            const std::string& hostName  = job.execHosts[hostI];
-
-            if (hostName != host.name)
-            {
-                continue;
-            }
-            else if (commonAttr.empty())
-            {
-                commonAttr = "<jobvalue jobid='" + job.fqJobId() + "' name='";
-            }
-
-            slots_used[queueName] = slots_used[queueName] + 1;
-
-            os  << xml::indent0 << "<job name='" << job.fqJobId() << "'>\n";
-
-
-            // queue instance
-            os  << xml::indent << commonAttr << "qinstance_name" << "'>"
-                << job.submit.queue << "@" << hostName
-                << "</jobvalue>\n";
-
-            os  << xml::indent << commonAttr << "job_name" << "'>"
-                << job.submit.jobName
-                << "</jobvalue>\n";
+            jobElement(os, jlist, job, host.name, true);
+            ++slotI;
+        }
 
-            os  << xml::indent << commonAttr << "job_owner" << "'>"
-                << job.user
-                << "</jobvalue>\n";
+        // the slave slots of a run are all the same
+        if (slotI < iter->count)
+        {
+            const size_t mark = os.size();
+            jobElement(os, jlist, job, host.name, false);
+            ++slotI;
 
-            os  << xml::indent << commonAttr << "job_state" << "'>";
-            if (job.isRunning())
-            {
-                os  << "r";
-            }
-            else if (job.isSuspend())
+            if (slotI < iter->count)
             {
-                os  << "s";
+                const std::string slave(os.str(), mark);
+                for (; slotI < iter->count; ++slotI)
+                {
+                    os.append(slave.data(), slave.size());
+                }
             }
-
-            os  << "</jobvalue>\n";
-
-            os  << xml::indent << commonAttr << "start_time" << "'>"
-                << job.startTime << "</jobvalue>\n";
-
-            os  << xml::indent << commonAttr << "pe_master" << "'>";
-            os  << (hostI ? "SLAVE" : "MASTER");
-            os  << "</jobvalue>\n";
-            os  << xml::indent0 << "</job>\n";
         }
     }
 
@@ -152,29 +208,27 @@ lsfutil::OutputQhost::print
     // write queue information
     for (unsigned queueI = 0; queueI < host.queues.size(); ++queueI)
     {
-        const std::string& queueName = host.queues[queueI];
+        const std::string& queueName = list.queueName(host.queues[queueI]);
 
         os  << xml::indent0 << "<queue name='" << queueName << "'>\n";
 
-        std::string commonAttr = "<queuevalue qname='" + queueName + "' name='";
-
         // assume everything is BATCH
-        os  << xml::indent << commonAttr << "qtype_string" << "'>"
+        queueValue(os, queueName, "qtype_string")
             << "BP"
             << "</queuevalue>\n";
 
         // slots used
-        os  << xml::indent << commonAttr << "slots_used" << "'>"
-            << slots_used[queueName]
+        queueValue(os, queueName, "slots_used")
+            << index.slotsUsed(hostI, queueI)
             << "</queuevalue>\n";
 
         // total jobs slots
-        os  << xml::indent << commonAttr << "slots" << "'>"
+        queueValue(os, queueName, "slots")
             << host.maxJobs
             << "</queuevalue>\n";
 
         // 'S' for suspend etc
-        os  << xml::indent << commonAttr << "state_string" << "'>"
+        queueValue(os, queueName, "state_string")
             << "</queuevalue>\n";
 
         os  << xml::indent0 << "</queue>\n";
@@ -188,12 +242,14 @@ lsfutil::OutputQhost::print
 
 // * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQhost::print
 (
-    std::ostream& os,
+    OutputBuffer& os,
     const lsfutil::LsfHostList& list,
-    const lsfutil::LsfJobList& jlist
+    const lsfutil::LsfJobList& jlist,
+    const lsfutil::LsfHostJobIndex& index,
+    const bool stale
 )
 {
     os  << "<?xml version='1.0'?>\n";
@@ -207,11 +263,12 @@ lsfutil::OutputQhost::print
 
     os  << "<qhost"
         << " xmlns:xsd='http://gridengine.sunsource.net/61/qhost'"
-        << " type='lsf' count='" << list.size() << "'>\n";
+        << " type='lsf' count='" << list.size() << "'"
+        << (stale ? " stale='true'" : "") << ">\n";
 
     for (unsigned hostI = 0; hostI < list.size(); ++hostI)
     {
-        print(os, list[hostI], jlist);
+        print(os, list, hostI, jlist, index);
     }
 
     os  << "</qhost>\n";
@@ -220,4 +277,34 @@ lsfutil::OutputQhost::print
 }
 
 
+lsfutil::OutputBuffer&
+lsfutil::OutputQhost::print
+(
+    OutputBuffer& os,
+    const lsfutil::LsfHostList& list,
+    const lsfutil::LsfJobList& jlist,
+    const bool stale
+)
+{
+    LsfArena arena;
+    return print(os, list, jlist, LsfHostJobIndex(list, jlist, arena), stale);
+}
+
+
+std::ostream&
+lsfutil::OutputQhost::print
+(
+    std::ostream& os,
+    const lsfutil::LsfHostList& list,
+    const lsfutil::LsfJobList& jlist,
+    const bool stale
+)
+{
+    OutputBuffer buf;
+    print(buf, list, jlist, stale);
+
+    return os << buf;
+}
+
+
 /* ************************************************************************* */
@@ -35,6 +35,8 @@ SourceFiles
 
 #include "lsfutil/LsfJobList.hpp"
 #include "lsfutil/LsfHostList.hpp"
+#include "lsfutil/LsfHostJobIndex.hpp"
+#include "lsfutil/OutputBuffer.hpp"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -49,22 +51,48 @@ class OutputQhost
 {
     // Private Member Functions
 
-        //- Print host information in XML format
-        static std::ostream& print
+        //- Print information for the hostI-th host in XML format
+        static OutputBuffer& print
         (
-            std::ostream&,
-            const LsfHostEntry&,
-            const LsfJobList&
+            OutputBuffer&,
+            const LsfHostList&,
+            unsigned hostI,
+            const LsfJobList&,
+            const LsfHostJobIndex&
         );
 
 public:
 
-        //- Print host list information in XML format
+        //- Print host list information in XML format,
+        //  using a prebuilt index of the job slots on the hosts,
+        //  optionally marking the information as stale
+        static OutputBuffer& print
+        (
+            OutputBuffer&,
+            const LsfHostList&,
+            const LsfJobList&,
+            const LsfHostJobIndex&,
+            const bool stale = false
+        );
+
+        //- Print host list information in XML format,
+        //  optionally marking the information as stale
+        static OutputBuffer& print
+        (
+            OutputBuffer&,
+            const LsfHostList&,
+            const LsfJobList&,
+            const bool stale = false
+        );
+
+        //- Print host list information in XML format,
+        //  optionally marking the information as stale
         static std::ostream& print
         (
             std::ostream&,
             const LsfHostList&,
-            const LsfJobList&
+            const LsfJobList&,
+            const bool stale = false
         );
 
 };
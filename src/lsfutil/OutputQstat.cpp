@@ -25,18 +25,19 @@ License
 
 // * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstat::print
 (
-    std::ostream& os,
-    const lsfutil::LsfJobEntry& job
+    OutputBuffer& os,
+    const lsfutil::LsfJobEntry& job,
+    const lsfutil::LsfStringPool& pool
 )
 {
     const lsfutil::LsfJobSubEntry& sub = job.submit;
 
     os  << xml::indent0
         << "<job_list type='lsf'"
-        << " state='" << job.status << "'>\n";
+        << " state='" << job.status() << "'>\n";
 
     os  << xml::indent << "<JB_job_number>"
         << job.jobId << "</JB_job_number>\n";
@@ -48,7 +49,7 @@ lsfutil::OutputQstat::print
     }
 
     // The name of the user who submitted the job
-    os  << xml::indent << xml::Tag("JB_owner", job.user) << "\n";
+    os  << xml::indent << xml::Tag("JB_owner", pool[job.user]) << "\n";
 
     os  << xml::indent;
 
@@ -63,7 +64,7 @@ lsfutil::OutputQstat::print
     }
     else
     {
-        os  << "<state>" << job.status[0] << "</state>\n";
+        os  << "<state>" << job.status()[0] << "</state>\n";
     }
 
     // <JAT_prio> ... </JAT_prio>
@@ -86,20 +87,19 @@ lsfutil::OutputQstat::print
     os  << xml::indent
         << xml::Tag("JB_cwd", job.cwd) << "\n";
 
-    print(os, sub);
+    print(os, sub, pool);
 
     // print queue_name which corresponds to the master process
     // or to the requested queue
-    if (sub.queue.size())
+    if (sub.queue)
     {
-        std::string qinstance = sub.queue;
+        os  << xml::indent << "<queue_name>" << xml::String(pool[sub.queue]);
 
         if (job.execHosts.size())
         {
-            qinstance += "@" + job.execHosts[0];
+            os  << '@' << xml::String(pool[job.execHosts[0].host]);
         }
-        os  << xml::indent
-            << xml::Tag("queue_name", qinstance) << "\n";
+        os  << "</queue_name>\n";
     }
 
     os  << xml::indent0 << "</job_list>\n";
@@ -108,11 +108,12 @@ lsfutil::OutputQstat::print
 }
 
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstat::print
 (
-    std::ostream& os,
-    const lsfutil::LsfJobSubEntry& sub
+    OutputBuffer& os,
+    const lsfutil::LsfJobSubEntry& sub,
+    const lsfutil::LsfStringPool& pool
 )
 {
     // The job name. If jobName is NULL, command is used as the job name.
@@ -127,13 +128,19 @@ lsfutil::OutputQstat::print
     // The number of invoker specified candidate hosts for running
     // the job. If numAskedHosts is 0, all qualified hosts will be
     // considered
-    xml::printList
-    (
-        os,
-        sub.askedHosts,
-        "asked-host-list",
-        "asked-host"
-    );
+    if (sub.askedHosts.size())
+    {
+        os  << xml::indent << "<asked-host-list count='"
+            << sub.askedHosts.size() << "'>\n";
+
+        for (unsigned i = 0; i < sub.askedHosts.size(); ++i)
+        {
+            os  << xml::indent << xml::indent0
+                << xml::Tag("asked-host", pool[sub.askedHosts[i]]) << "\n";
+        }
+
+        os  << xml::indent << "</asked-host-list>\n";
+    }
 
     // The resource requirements of the job.
     // If resReq is NULL, the batch system will try to obtain
@@ -141,19 +148,19 @@ lsfutil::OutputQstat::print
     // lists (see \ref ls_task ). If the task does not appear in the
     // remote task lists, then the default resource requirement
     // is to run on host() of the same type.
-    LsfCore::rusage_map rusage = LsfCore::parseRusage(sub.resReq);
+    // Only the preferred alternative of the rusage
     for
     (
-        LsfCore::rusage_map::const_iterator iter = rusage.begin();
-        iter != rusage.end();
+        LsfRusage::const_iterator iter = sub.rusage.begin();
+        iter != sub.rusage.end() && !iter->alternative;
         ++iter
     )
     {
         os  << xml::indent
             << "<hard_request name='"
-            << iter->first
+            << pool[iter->name]
             << "' resource_contribution='0.0'>"
-            << iter->second
+            << pool[iter->value]
             << "</hard_request>" << "\n";
     }
 
@@ -256,10 +263,10 @@ lsfutil::OutputQstat::print
     }
 
     // The name of the project the job will be charged to.
-    if (sub.projectName.size())
+    if (sub.projectName)
     {
         os  << xml::indent
-            << xml::Tag("project", sub.projectName) << "\n";
+            << xml::Tag("project", pool[sub.projectName]) << "\n";
     }
 
     // Specified login shell used to initialize the execution
@@ -320,11 +327,12 @@ lsfutil::OutputQstat::print
 
 // * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstat::print
 (
-    std::ostream& os,
-    const lsfutil::LsfJobList& list
+    OutputBuffer& os,
+    const lsfutil::LsfJobList& list,
+    const bool stale
 )
 {
     os  << "<?xml version='1.0'?>\n";
@@ -338,7 +346,8 @@ lsfutil::OutputQstat::print
 
     os  << "<job_info"
         << " xmlns:xsd='http://www.w3.org/2001/XMLSchema'"
-        << " type='lsf' count='" << list.size() << "'>\n";
+        << " type='lsf' count='" << list.size() << "'"
+        << (stale ? " stale='true'" : "") << ">\n";
 
 
     // active jobs:
@@ -347,7 +356,7 @@ lsfutil::OutputQstat::print
     {
         if (list[jobI].isRunning())
         {
-            print(os, list[jobI]);
+            print(os, list[jobI], list.strings());
         }
     }
     os  << "</queue_info>\n";
@@ -359,7 +368,7 @@ lsfutil::OutputQstat::print
     {
         if (list[jobI].isPending())
         {
-            print(os, list[jobI]);
+            print(os, list[jobI], list.strings());
         }
     }
     os  << "</job_info>\n";
@@ -371,4 +380,19 @@ lsfutil::OutputQstat::print
 }
 
 
+std::ostream&
+lsfutil::OutputQstat::print
+(
+    std::ostream& os,
+    const lsfutil::LsfJobList& list,
+    const bool stale
+)
+{
+    OutputBuffer buf;
+    print(buf, list, stale);
+
+    return os << buf;
+}
+
+
 /* ************************************************************************* */
@@ -34,6 +34,7 @@ SourceFiles
 #include <iostream>
 
 #include "lsfutil/LsfJobList.hpp"
+#include "lsfutil/OutputBuffer.hpp"
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -49,15 +50,40 @@ class OutputQstat
     // Private Member Functions
 
         //- Print job information in XML format
-        static std::ostream& print(std::ostream&, const LsfJobEntry&);
+        static OutputBuffer& print
+        (
+            OutputBuffer&,
+            const LsfJobEntry&,
+            const LsfStringPool&
+        );
 
         //- Print submit information in XML format
-        static std::ostream& print(std::ostream&, const LsfJobSubEntry&);
+        static OutputBuffer& print
+        (
+            OutputBuffer&,
+            const LsfJobSubEntry&,
+            const LsfStringPool&
+        );
 
 public:
 
-        //- Print job list information in XML format
-        static std::ostream& print(std::ostream&, const LsfJobList&);
+        //- Print job list information in XML format,
+        //  optionally marking the information as stale
+        static OutputBuffer& print
+        (
+            OutputBuffer&,
+            const LsfJobList&,
+            const bool stale = false
+        );
+
+        //- Print job list information in XML format,
+        //  optionally marking the information as stale
+        static std::ostream& print
+        (
+            std::ostream&,
+            const LsfJobList&,
+            const bool stale = false
+        );
 
 };
 
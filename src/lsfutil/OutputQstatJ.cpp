@@ -24,11 +24,12 @@ License
 
 // * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstatJ::print
 (
-    std::ostream& os,
-    const lsfutil::LsfJobEntry& job
+    OutputBuffer& os,
+    const lsfutil::LsfJobEntry& job,
+    const lsfutil::LsfStringPool& pool
 )
 {
     const lsfutil::LsfJobSubEntry& sub = job.submit;
@@ -45,7 +46,7 @@ lsfutil::OutputQstatJ::print
     }
 
     // The name of the user who submitted the job
-    os  << xml::indent << xml::Tag("JB_owner", job.user) << "\n";
+    os  << xml::indent << xml::Tag("JB_owner", pool[job.user]) << "\n";
 
     os  << xml::indent << xml::Tag("JB_job_name", sub.jobName) << "\n";
 
@@ -59,23 +60,21 @@ lsfutil::OutputQstatJ::print
         << xml::indent << "</JB_stdout_path_list>\n";
 
 
-    if (sub.queue.size())
+    if (sub.queue)
     {
         os  << xml::indent
-            << xml::Tag("JB_hard_queue_list", sub.queue) << "\n";
+            << xml::Tag("JB_hard_queue_list", pool[sub.queue]) << "\n";
     }
 
-    // rusage
-    LsfCore::rusage_map rusage = LsfCore::parseRusage(sub.resReq);
-
-    if (rusage.size())
+    // rusage, the preferred alternative only
+    if (!sub.rusage.empty() && !sub.rusage.begin()->alternative)
     {
         os  << xml::indent << "<JB_hard_resource_list>\n";
 
         for
         (
-            LsfCore::rusage_map::const_iterator iter = rusage.begin();
-            iter != rusage.end();
+            LsfRusage::const_iterator iter = sub.rusage.begin();
+            iter != sub.rusage.end() && !iter->alternative;
             ++iter
         )
         {
@@ -83,9 +82,9 @@ lsfutil::OutputQstatJ::print
                 << "<qstat_l_requests>\n";
 
             os  << xml::indent << xml::indent
-                << xml::Tag("CE_name", iter->first) << "\n";
+                << xml::Tag("CE_name", pool[iter->name]) << "\n";
             os  << xml::indent << xml::indent
-                << xml::Tag("CE_stringval", iter->second) << "\n";
+                << xml::Tag("CE_stringval", pool[iter->value]) << "\n";
 
             os  << xml::indent << xml::indent0
                 << "</qstat_l_requests>\n";
@@ -155,11 +154,12 @@ lsfutil::OutputQstatJ::print
 
 // * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstatJ::print
 (
-    std::ostream& os,
-    const lsfutil::LsfJobList& list
+    OutputBuffer& os,
+    const lsfutil::LsfJobList& list,
+    const bool stale
 )
 {
     os  << "<?xml version='1.0'?>\n";
@@ -173,7 +173,8 @@ lsfutil::OutputQstatJ::print
 
     os  << "<detailed_job_info"
         << " xmlns:xsd='http://www.w3.org/2001/XMLSchema'"
-        << " type='lsf' count='" << list.size() << "'>\n";
+        << " type='lsf' count='" << list.size() << "'"
+        << (stale ? " stale='true'" : "") << ">\n";
 
     os  << "<djob_info>\n";
 
@@ -184,7 +185,7 @@ lsfutil::OutputQstatJ::print
 
         if (job.isRunning())
         {
-            print(os, job);
+            print(os, job, list.strings());
         }
     }
 
@@ -195,7 +196,7 @@ lsfutil::OutputQstatJ::print
 
         if (job.isPending())
         {
-            print(os, job);
+            print(os, job, list.strings());
         }
     }
 
@@ -206,12 +207,13 @@ lsfutil::OutputQstatJ::print
 }
 
 
-std::ostream&
+lsfutil::OutputBuffer&
 lsfutil::OutputQstatJ::print
 (
-    std::ostream& os,
+    OutputBuffer& os,
     const lsfutil::LsfJobList& list,
-    const std::vector<int>& indices
+    const std::vector<int>& indices,
+    const bool stale
 )
 {
     os  << "<?xml version='1.0'?>\n";
@@ -225,7 +227,8 @@ lsfutil::OutputQstatJ::print
 
     os  << "<detailed_job_info"
         << " xmlns:xsd='http://www.w3.org/2001/XMLSchema'"
-        << " type='lsf' count='" << indices.size() << "'>\n";
+        << " type='lsf' count='" << indices.size() << "'"
+        << (stale ? " stale='true'" : "") << ">\n";
 
     os  << "<djob_info>\n";
 
@@ -236,7 +239,7 @@ lsfutil::OutputQstatJ::print
 
         if (job.isRunning())
         {
-            print(os, job);
+            print(os, job, list.strings());
         }
     }
 
@@ -247,7 +250,7 @@ lsfutil::OutputQstatJ::print
 
         if (job.isPending())
         {
-            print(os, job);
+            print(os, job, list.strings());
         }
     }
 
@@ -258,4 +261,36 @@ lsfutil::OutputQstatJ::print
 }
 
 
+
+std::ostream&
+lsfutil::OutputQstatJ::print
+(
+    std::ostream& os,
+    const lsfutil::LsfJobList& list,
+    const bool stale
+)
+{
+    OutputBuffer buf;
+    print(buf, list, stale);
+
+    return os << buf;
+}
+
+
+std::ostream&
+lsfutil::OutputQstatJ::print
+(
+    std::ostream& os,
+    const lsfutil::LsfJobList& list,
+    const std::vector<int>& indices,
+    const bool stale
+)
+{
+    OutputBuffer buf;
+    print(buf, list, indices, stale);
+
+    return os << buf;
+}
+
+
 /* ************************************************************************* */
@@ -20,6 +20,16 @@ License
 \*---------------------------------------------------------------------------*/
 
 #include "lsfutil/XmlUtils.hpp"
+#include "lsfutil/OutputBuffer.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
 
 
 // * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
@@ -28,8 +38,145 @@ const char* const lsfutil::xml::indent0 = "  ";
 const char* const lsfutil::xml::indent  = "    ";
 
 
+//! \cond local scope
+
+// characters that need transliteration:
+// the reserved XML characters, control characters and non-ASCII
+static inline bool isSpecial(unsigned char c)
+{
+    switch (c)
+    {
+        case '&':
+        case '<':
+        case '>':
+        case '"':
+        case '\'':
+            return true;
+
+        default:
+            return (c < 32 || c >= 127);
+    }
+}
+
+
+#if defined(__AVX2__)
+
+// the bits of the special characters in a block of 32,
+// a signed compare catches both control characters and non-ASCII
+static inline unsigned specialMask(const char* p)
+{
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+
+    __m256i m = _mm256_cmpgt_epi8(_mm256_set1_epi8(32), v);
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(127)));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('&')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('<')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('>')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\'')));
+
+    return _mm256_movemask_epi8(m);
+}
+
+static const size_t blockSize = 32;
+
+#elif defined(__SSE2__)
+
+// the bits of the special characters in a block of 16,
+// a signed compare catches both control characters and non-ASCII
+static inline unsigned specialMask(const char* p)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+
+    __m128i m = _mm_cmplt_epi8(v, _mm_set1_epi8(32));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(127)));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('&')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('<')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('>')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\'')));
+
+    return _mm_movemask_epi8(m);
+}
+
+static const size_t blockSize = 16;
+
+#endif
+
+//! \endcond
+
+
 // * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
 
+size_t lsfutil::xml::cleanRun(const char* beg, const char* end)
+{
+    const char* p = beg;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    while (size_t(end - p) >= blockSize)
+    {
+        const unsigned mask = specialMask(p);
+        if (mask)
+        {
+            return (p - beg) + __builtin_ctz(mask);
+        }
+        p += blockSize;
+    }
+#endif
+
+    while (p != end && !isSpecial(*p))
+    {
+        ++p;
+    }
+
+    return p - beg;
+}
+
+
+size_t lsfutil::xml::entity(char c, char* buf)
+{
+    const char* named;
+    size_t len;
+
+    switch (c)
+    {
+        case '&':
+            named = "&amp;";
+            len = 5;
+            break;
+        case '<':
+            named = "&lt;";
+            len = 4;
+            break;
+        case '>':
+            named = "&gt;";
+            len = 4;
+            break;
+        case '"':
+            named = "&quot;";
+            len = 6;
+            break;
+        case '\'':
+            named = "&apos;";
+            len = 6;
+            break;
+
+        default:
+            // numeric reference to the (signed) char value
+            return ::snprintf
+            (
+                buf,
+                entitySize,
+                "&#%u;",
+                static_cast<unsigned int>(c)
+            );
+    }
+
+    ::memcpy(buf, named, len);
+    return len;
+}
+
+
 std::ostream& lsfutil::xml::printList
 (
     std::ostream& os,
@@ -61,17 +208,78 @@ std::ostream& lsfutil::xml::printList
 }
 
 
+lsfutil::OutputBuffer& lsfutil::xml::printList
+(
+    OutputBuffer& os,
+    const std::vector<std::string>& list,
+    const char* listTag,
+    const char* elemTag
+)
+{
+    if (list.size())
+    {
+        os  << indent << "<" << listTag
+            <<" count='" << list.size() << "'>\n";
+
+        for
+        (
+            std::vector<std::string>::const_iterator iter = list.begin();
+            iter != list.end();
+            ++iter
+        )
+        {
+            os  << xml::indent << xml::indent0
+                << xml::Tag(elemTag, *iter) << "\n";
+        }
+
+        os  <<  xml::indent << "</" << listTag << ">\n";
+    }
+
+    return os;
+}
+
+
 // * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
 
+std::ostream& lsfutil::xml::String::print(std::ostream& os) const
+{
+    const char* p = str_;
+    const char* const end = p + size_;
+
+    while (p != end)
+    {
+        const size_t clean = cleanRun(p, end);
+        if (clean)
+        {
+            os.write(p, clean);
+            p += clean;
+
+            if (p == end)
+            {
+                break;
+            }
+        }
+
+        char ref[entitySize];
+        os.write(ref, entity(*p, ref));
+
+        ++p;
+    }
+
+    return os;
+}
+
+
 std::string lsfutil::xml::TimeTag::iso8601() const
 {
     char buf[32];
+    struct tm tmval;
     ::strftime
     (
         buf,
         sizeof(buf),
         "%Y-%m-%dT%H:%M:%S",
-        ::localtime(&epoch_)
+        ::localtime_r(&epoch_, &tmval)
     );
 
     return buf;
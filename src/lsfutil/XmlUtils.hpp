@@ -33,11 +33,16 @@ Description
 #include <vector>
 #include <iostream>
 
+#include "lsfutil/LsfText.hpp"
+
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
 namespace lsfutil
 {
 
+// Forward declaration of classes
+class OutputBuffer;
+
 namespace xml
 {
     //- half indentation
@@ -46,6 +51,18 @@ namespace xml
     //- Full indentation
     extern const char* const indent;
 
+    //- The length of the leading run of characters that do not need
+    //  to be transliterated
+    size_t cleanRun(const char* beg, const char* end);
+
+    //- The size of a buffer that holds any character reference
+    const size_t entitySize = 16;
+
+    //- Write the character reference that transliterates the character:
+    //  named for the reserved XML characters, otherwise numeric.
+    //  \return its length, the buffer must hold entitySize characters
+    size_t entity(char c, char* buf);
+
     //- Simple output of a list
     std::ostream& printList
     (
@@ -55,6 +72,15 @@ namespace xml
         const char* elemTag
     );
 
+    //- Simple output of a list
+    OutputBuffer& printList
+    (
+        OutputBuffer& os,
+        const std::vector<std::string>& list,
+        const char* listTag,
+        const char* elemTag
+    );
+
 
 /*---------------------------------------------------------------------------*\
                           Class xml::String Declaration
@@ -63,67 +89,39 @@ namespace xml
 //! Helper to transliterate reserved XML characters on output
 class String
 {
-    const std::string& str_;
+    const char* str_;
+    size_t size_;
 
 public:
 
+    friend class lsfutil::OutputBuffer;
+
     //- Construct from a const reference
     String(const std::string& s)
     :
-        str_(s)
+        str_(s.data()),
+        size_(s.size())
+    {}
+
+    //- Construct from a const reference
+    String(const LsfText& s)
+    :
+        str_(s.data()),
+        size_(s.size())
     {}
 
 
     //- The size of the referenced string
     inline bool size() const
     {
-        return str_.size();
+        return size_;
     }
 
 
-    //- Output with reserved XML characters transliterated
-    std::ostream& print(std::ostream& os) const
-    {
-        for
-        (
-            std::string::const_iterator iter = str_.begin();
-            iter != str_.end();
-            ++iter
-        )
-        {
-            switch (*iter)
-            {
-                case '&':
-                    os  << "&amp;";
-                    break;
-                case '<':
-                    os  << "&lt;";
-                    break;
-                case '>':
-                    os  << "&gt;";
-                    break;
-                case '"':
-                    os  << "&quot;";
-                    break;
-                case '\'':
-                    os  << "&apos;";
-                    break;
-
-                default:
-                    if (*iter >= 32 && *iter < 127)
-                    {
-                        os  << *iter;
-                    }
-                    else
-                    {
-                        os  << "&#" << static_cast<unsigned int>(*iter) << ';';
-                    }
-                    break;
-            }
-        }
-
-        return os;
-    }
+    //- Output with reserved XML characters transliterated.
+    //  Runs of ordinary characters are found a block at a time
+    //  (with SSE2/AVX2 where available) and written in one go.
+    std::ostream& print(std::ostream& os) const;
 
 
     //- Output with reserved XML characters transliterated
@@ -142,13 +140,22 @@ public:
 //! Helper to output a tag with string content
 class Tag
 {
-    const std::string tag_;
+    const char* tag_;
     const xml::String val_;
 
 public:
 
+    friend class lsfutil::OutputBuffer;
+
     //- Construct from a tag name and the value
-    Tag(const std::string& tag, const std::string& val)
+    Tag(const char* tag, const std::string& val)
+    :
+        tag_(tag),
+        val_(val)
+    {}
+
+    //- Construct from a tag name and the value
+    Tag(const char* tag, const LsfText& val)
     :
         tag_(tag),
         val_(val)
@@ -181,13 +188,15 @@ public:
 //! Helper to output a time tag in ISO-8601 format
 class TimeTag
 {
-    const std::string tag_;
+    const char* tag_;
     const time_t epoch_;
 
 public:
 
+    friend class lsfutil::OutputBuffer;
+
     //- Construct from a tag name and the time value
-    TimeTag(const std::string& tag, const time_t& epoch)
+    TimeTag(const char* tag, const time_t& epoch)
     :
         tag_(tag),
         epoch_(epoch)
@@ -0,0 +1,207 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/HttpConnection.hpp"
+#include "markutil/HttpRequest.hpp"
+
+#include <cerrno>
+#include <sstream>
+#include <unistd.h>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+unsigned markutil::HttpConnection::maxHeaderSize = 65536;
+
+unsigned markutil::HttpConnection::idleTimeout = 30;
+
+unsigned markutil::HttpConnection::keepAliveTimeout = 5;
+
+unsigned markutil::HttpConnection::maxRequests = 100;
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void markutil::HttpConnection::scan()
+{
+    // the header ends with a blank line: "\n\n" or "\n\r\n"
+    std::string::size_type pos = scanned_;
+
+    while
+    (
+        headerEnd_ == std::string::npos
+     && (pos = buffer_.find('\n', pos)) != std::string::npos
+    )
+    {
+        if (pos + 1 < buffer_.size() && buffer_[pos+1] == '\n')
+        {
+            headerEnd_ = pos + 2;
+        }
+        else if
+        (
+            pos + 2 < buffer_.size()
+         && buffer_[pos+1] == '\r'
+         && buffer_[pos+2] == '\n'
+        )
+        {
+            headerEnd_ = pos + 3;
+        }
+        else if (pos + 2 >= buffer_.size())
+        {
+            // incomplete - rescan from here when more arrives
+            break;
+        }
+
+        ++pos;
+    }
+
+    scanned_ = (pos == std::string::npos ? buffer_.size() : pos);
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::HttpConnection::HttpConnection(int fd)
+:
+    fd_(fd),
+    buffer_(),
+    scanned_(0),
+    headerEnd_(std::string::npos),
+    lastActive_(time(0)),
+    requests_(0),
+    info_(),
+    output_(fd),
+    finished_(false),
+    capped_(false)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+markutil::HttpConnection::~HttpConnection()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+bool markutil::HttpConnection::overflow() const
+{
+    return !hasRequest() && buffer_.size() > maxHeaderSize;
+}
+
+
+bool markutil::HttpConnection::expired(time_t now) const
+{
+    const bool waiting = requests_ && buffer_.empty() && output_.empty();
+
+    return
+    (
+        now - lastActive_
+      > time_t(waiting ? keepAliveTimeout : idleTimeout)
+    );
+}
+
+
+bool markutil::HttpConnection::fill(bool drain)
+{
+    char buf[4096];
+    bool ok = true;
+
+    // read until drained, but not beyond the maximum header size
+    capped_ = true;
+    while (buffer_.size() <= maxHeaderSize)
+    {
+        const ssize_t n = ::read(fd_, buf, sizeof(buf));
+
+        if (n > 0)
+        {
+            // nothing is taken from a finished connection
+            if (!finished_)
+            {
+                buffer_.append(buf, n);
+            }
+            lastActive_ = time(0);
+
+            if (drain)
+            {
+                continue;
+            }
+        }
+        else if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if
+        (
+            n == 0 || !drain
+         || (errno != EAGAIN && errno != EWOULDBLOCK)
+        )
+        {
+            ok = false;     // end-of-file, error or timeout
+        }
+
+        capped_ = false;
+        break;
+    }
+
+    scan();
+
+    return ok;
+}
+
+
+void markutil::HttpConnection::finish()
+{
+    finished_ = true;
+
+    buffer_.clear();
+    scanned_ = 0;
+    headerEnd_ = std::string::npos;
+}
+
+
+bool markutil::HttpConnection::nextRequest(HttpRequest& req)
+{
+    if (!hasRequest())
+    {
+        return false;
+    }
+
+    std::istringstream is(buffer_.substr(0, headerEnd_));
+    req.readHeader(is);
+
+    if (!requests_)
+    {
+        info_.setInfo(fd_);
+    }
+    req.socketInfo() = info_;
+    ++requests_;
+
+    buffer_.erase(0, headerEnd_);
+    scanned_ = 0;
+    headerEnd_ = std::string::npos;
+    scan();
+
+    return true;
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,244 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    markutil::HttpConnection
+
+Description
+    The state of a client connection for an event-driven server.
+
+    Input from a non-blocking socket is accumulated until a complete
+    request header (terminated by a blank line) is available, so that
+    a slow client never blocks the server.
+
+    A connection may carry several requests (HTTP/1.1 keep-alive),
+    which may also arrive together (pipelining). The requests are taken
+    from the input in order. The host/peer information is looked up only
+    once per connection.
+
+    Likewise, the output that the socket does not take is kept with the
+    connection until it becomes writable, so that a slow reader never
+    blocks the server either. A connection can be finished: no further
+    requests are taken, and it is closed once its output has been sent.
+
+SourceFiles
+    HttpConnection.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_HTTP_CONNECTION_H
+#define MARK_HTTP_CONNECTION_H
+
+#include "markutil/SocketInfo.hpp"
+#include "markutil/SocketOutput.hpp"
+
+#include <ctime>
+#include <string>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+// Forward declaration of classes
+class HttpRequest;
+
+
+/*---------------------------------------------------------------------------*\
+                        Class HttpConnection Declaration
+\*---------------------------------------------------------------------------*/
+
+class HttpConnection
+{
+    // Private data
+
+        //- The socket file descriptor
+        int fd_;
+
+        //- The input received so far
+        std::string buffer_;
+
+        //- The input already searched for the end of the header
+        std::string::size_type scanned_;
+
+        //- The end of the header within the buffer, npos if incomplete
+        std::string::size_type headerEnd_;
+
+        //- The time of the last activity
+        time_t lastActive_;
+
+        //- The number of requests taken from the input
+        unsigned requests_;
+
+        //- The host/peer information, once looked up
+        SocketInfo info_;
+
+        //- The output not yet sent
+        SocketOutput output_;
+
+        //- No further requests are taken
+        bool finished_;
+
+        //- The last fill() stopped at the maxHeaderSize, not at the end
+        //  of the available input
+        bool capped_;
+
+
+    // Private Member Functions
+
+        //- Search the new input for the end of the header
+        void scan();
+
+
+public:
+
+    // Static data members
+
+        //- The maximum size of a request header
+        static unsigned maxHeaderSize;
+
+        //- The time (seconds) after which an idle connection is dropped
+        static unsigned idleTimeout;
+
+        //- The time (seconds) to wait for another request on a
+        //  persistent connection
+        static unsigned keepAliveTimeout;
+
+        //- The maximum number of requests on a persistent connection
+        static unsigned maxRequests;
+
+
+    // Constructors
+
+        //- Construct for the given (non-blocking) socket
+        explicit HttpConnection(int fd = -1);
+
+
+    //- Destructor, does not close the socket
+    ~HttpConnection();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The socket file descriptor
+            int fd() const
+            {
+                return fd_;
+            }
+
+            //- The time of the last activity
+            time_t lastActive() const
+            {
+                return lastActive_;
+            }
+
+            //- True if a complete request header has been received
+            bool hasRequest() const
+            {
+                return headerEnd_ != std::string::npos;
+            }
+
+            //- True if the header exceeds the maxHeaderSize
+            bool overflow() const;
+
+            //- The number of requests taken from the input
+            unsigned requests() const
+            {
+                return requests_;
+            }
+
+            //- True if the connection may carry another request
+            bool persistent() const
+            {
+                return requests_ < maxRequests;
+            }
+
+            //- True if the connection has been idle for too long:
+            //  keepAliveTimeout between requests, otherwise idleTimeout
+            bool expired(time_t now) const;
+
+            //- The output not yet sent
+            const SocketOutput& output() const
+            {
+                return output_;
+            }
+
+            //- True if no further requests are taken
+            bool finished() const
+            {
+                return finished_;
+            }
+
+            //- True if the last fill() left input on the socket, to be
+            //  read once the requests received are answered
+            bool capped() const
+            {
+                return capped_;
+            }
+
+            //- True if the connection is finished and its output sent
+            bool done() const
+            {
+                return finished_ && output_.empty();
+            }
+
+
+        // Edit
+
+            //- Read all input currently available on the socket,
+            //  or only read once (blocking socket) without drain
+            //  \return false on end-of-file, error or a receive timeout
+            //  on a blocking socket
+            bool fill(bool drain = true);
+
+            //- Parse the next complete request header and remove it from
+            //  the input, with the host/peer information of the connection
+            //  \return false if there is no complete request header
+            bool nextRequest(HttpRequest&);
+
+            //- Mark the connection as active, eg after a reply
+            void touch()
+            {
+                lastActive_ = time(0);
+            }
+
+            //- The output not yet sent
+            SocketOutput& output()
+            {
+                return output_;
+            }
+
+            //- Take no further requests, close once the output is sent.
+            //  Discards the remaining input, eg an unread request body
+            void finish();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_HTTP_CONNECTION_H
+
+// ************************************************************************* //
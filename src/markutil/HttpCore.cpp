@@ -22,13 +22,15 @@ License
 #include "markutil/HttpCore.hpp"
 
 #include <ctime>
-#include <clocale>
+#include <cstdio>
 #include <cstring>
 #include <string>
 #include <sstream>
 #include <vector>
 
+#include <pthread.h>
 #include <sys/stat.h>
+#include <zlib.h>
 
 
 // * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
@@ -39,16 +41,53 @@ const std::string markutil::HttpCore::nullString;
 // * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
 
 //! \cond local scope
-static inline const std::string& hexEncode(char ch)
+static inline void hexEncode(std::string& url, char ch)
 {
-    static char hex[] = "0123456789ABCDEF";
-    static std::string buf('%', 3);
+    static const char hex[] = "0123456789ABCDEF";
 
-    buf[0] = '%';
-    buf[1] = hex[((ch >> 4) & 0x0F)];
-    buf[2] = hex[(ch & 0x0F)];
+    url += '%';
+    url += hex[((ch >> 4) & 0x0F)];
+    url += hex[(ch & 0x0F)];
+}
 
-    return buf;
+
+// the mime-types, populated once
+static markutil::HttpCore::RawHeaderType mimeLookup_;
+static pthread_once_t mimeOnce_ = PTHREAD_ONCE_INIT;
+
+// month names for RFC1123 dates, independent of the locale
+static const char* const months[12] =
+{
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+static void populateMime()
+{
+    markutil::HttpCore::RawHeaderType& lookup = mimeLookup_;
+
+    // text
+    lookup["css"]  = "text/css";
+    lookup["htm"]  = "text/html";
+    lookup["html"] = "text/html";
+    lookup["txt"]  = "text/plain";
+    lookup["xml"]  = "text/xml";
+    lookup["xsl"]  = "text/xsl";
+    lookup["xhtml"] = "application/xhtml+xml";
+
+    // image
+    lookup["gif"]  = "image/gif";
+    lookup["ico"]  = "image/x-icon";
+    lookup["jpeg"] = "image/jpeg";
+    lookup["jpg"]  = "image/jpeg";
+    lookup["png"]  = "image/png";
+
+    // application
+    lookup["gz"]   = "application/x-gzip";
+    lookup["js"]   = "application/javascript";
+    lookup["pdf"]  = "application/pdf";
+    lookup["tar"]  = "application/x-tar";
+    lookup["zip"]  = "application/x-zip-compressed";
 }
 //! \endcond
 
@@ -56,12 +95,32 @@ static inline const std::string& hexEncode(char ch)
 // date in RFC1123 format
 // eg
 //     Sun, 06 Nov 1994 08:49:37 GMT
+// the names are always english, independent of the locale
 std::string markutil::HttpCore::timestring(const time_t& timestamp)
 {
-    char buf[30];
-    char *prev = setlocale(LC_TIME, "C"); // english locale
-    strftime(buf, 30, "%a, %d %b %Y %H:%M:%S GMT", ::gmtime(&timestamp));
-    setlocale(LC_TIME, prev);             // restore locale
+    static const char* const days[7] =
+    {
+        "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+    };
+
+    struct tm tmval;
+    ::gmtime_r(&timestamp, &tmval);
+
+    char buf[32];
+    snprintf
+    (
+        buf,
+        sizeof(buf),
+        "%s, %02d %s %04d %02d:%02d:%02d GMT",
+        days[tmval.tm_wday],
+        tmval.tm_mday,
+        months[tmval.tm_mon],
+        tmval.tm_year + 1900,
+        tmval.tm_hour,
+        tmval.tm_min,
+        tmval.tm_sec
+    );
+
     return buf;
 }
 
@@ -72,36 +131,71 @@ std::string markutil::HttpCore::timestring()
 }
 
 
-const std::string& markutil::HttpCore::lookupMime(const std::string& ext)
+time_t markutil::HttpCore::parseTime(const std::string& str)
 {
-    static RawHeaderType lookup;
+    const char* s = str.c_str();
 
-    // populate lookup table on the first call
-    if (lookup.empty())
+    char mon[4];
+    int day, year, hour, min, sec;
+
+    // RFC1123: "Sun, 06 Nov 1994 08:49:37 GMT"
+    // RFC850:  "Sunday, 06-Nov-94 08:49:37 GMT"
+    // asctime: "Sun Nov  6 08:49:37 1994"
+    if
+    (
+        sscanf(s, "%*[a-zA-Z], %d %3s %d %d:%d:%d",
+            &day, mon, &year, &hour, &min, &sec) == 6
+    )
+    {}
+    else if
+    (
+        sscanf(s, "%*[a-zA-Z], %d-%3s-%d %d:%d:%d",
+            &day, mon, &year, &hour, &min, &sec) == 6
+    )
+    {
+        year += (year < 70 ? 2000 : year < 100 ? 1900 : 0);
+    }
+    else if
+    (
+        sscanf(s, "%*[a-zA-Z] %3s %d %d:%d:%d %d",
+            mon, &day, &hour, &min, &sec, &year) != 6
+    )
+    {
+        return 0;
+    }
+
+    int monI = 0;
+    while (monI < 12 && strcmp(mon, months[monI]))
+    {
+        ++monI;
+    }
+
+    if (monI == 12)
     {
-        // text
-        lookup["css"]  = "text/css";
-        lookup["htm"]  = "text/html";
-        lookup["html"] = "text/html";
-        lookup["txt"]  = "text/plain";
-        lookup["xml"]  = "text/xml";
-        lookup["xsl"]  = "text/xsl";
-        lookup["xhtml"] = "application/xhtml+xml";
-
-        // image
-        lookup["gif"]  = "image/gif";
-        lookup["ico"]  = "image/x-icon";
-        lookup["jpeg"] = "image/jpeg";
-        lookup["jpg"]  = "image/jpeg";
-        lookup["png"]  = "image/png";
-
-        // application
-        lookup["gz"]   = "application/x-gzip";
-        lookup["pdf"]  = "application/pdf";
-        lookup["tar"]  = "application/x-tar";
-        lookup["zip"]  = "application/x-zip-compressed";
+        return 0;
     }
 
+    struct tm tmval;
+    memset(&tmval, 0, sizeof(tmval));
+    tmval.tm_year = year - 1900;
+    tmval.tm_mon  = monI;
+    tmval.tm_mday = day;
+    tmval.tm_hour = hour;
+    tmval.tm_min  = min;
+    tmval.tm_sec  = sec;
+
+    const time_t t = ::timegm(&tmval);
+
+    return (t == time_t(-1) ? 0 : t);
+}
+
+
+const std::string& markutil::HttpCore::lookupMime(const std::string& ext)
+{
+    // populate lookup table on the first call
+    ::pthread_once(&mimeOnce_, populateMime);
+    const RawHeaderType& lookup = mimeLookup_;
+
     if (ext.empty())
     {
         return nullString;
@@ -134,7 +228,7 @@ std::string& markutil::HttpCore::httpAppendUrl(std::string& url, char ch)
         case ';' :   // field separator
         case '=' :   // field=value
         case '?' :   // query
-            url += hexEncode(ch);
+            hexEncode(url, ch);
             break;
 
         default :
@@ -144,7 +238,7 @@ std::string& markutil::HttpCore::httpAppendUrl(std::string& url, char ch)
             }
             else
             {
-                url += hexEncode(ch);
+                hexEncode(url, ch);
             }
             break;
     }
@@ -362,6 +456,52 @@ bool markutil::HttpCore::isFile(const std::string& name)
 }
 
 
+bool markutil::HttpCore::gzip
+(
+    std::string& out,
+    const char* data,
+    size_t len
+)
+{
+    out.clear();
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+
+    // windowBits + 16 for a gzip header and trailer
+    if
+    (
+        deflateInit2
+        (
+            &strm,
+            Z_DEFAULT_COMPRESSION,
+            Z_DEFLATED,
+            15 + 16,
+            8,
+            Z_DEFAULT_STRATEGY
+        ) != Z_OK
+    )
+    {
+        return false;
+    }
+
+    out.resize(deflateBound(&strm, len));
+
+    strm.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    strm.avail_in  = len;
+    strm.next_out  = reinterpret_cast<Bytef*>(&out[0]);
+    strm.avail_out = out.size();
+
+    // the bound guarantees a single call suffices
+    const bool ok = (deflate(&strm, Z_FINISH) == Z_STREAM_END);
+
+    out.resize(ok ? strm.total_out : 0);
+    deflateEnd(&strm);
+
+    return ok;
+}
+
+
 // * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
 
 markutil::HttpCore::HttpCore()
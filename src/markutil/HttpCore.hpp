@@ -31,6 +31,7 @@ SourceFiles
 #define MARK_HTTP_CORE_H
 
 #include <cstring>
+#include <ctime>
 #include <string>
 #include <map>
 #include <iostream>
@@ -100,6 +101,10 @@ public:
         //! Return current time as RFC1123-compliant string
         static std::string timestring();
 
+        //! Parse an HTTP date (RFC1123, RFC850 or asctime format)
+        //  Return 0 if it cannot be parsed
+        static time_t parseTime(const std::string&);
+
         //! Return mime-type corresponding to the extension name
         static const std::string& lookupMime(const std::string& ext);
 
@@ -152,6 +157,16 @@ public:
         static bool isFile(const std::string& name);
 
 
+        //! Compress data in gzip format (RFC1952) with zlib
+        //  Return false on failure
+        static bool gzip
+        (
+            std::string& out,
+            const char* data,
+            size_t len
+        );
+
+
         //! Read header lines of form "Key: Value ..."
         //  Return the number read
         int readHeader(std::istream&);
@@ -0,0 +1,268 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/HttpFileCache.hpp"
+#include "markutil/HttpCore.hpp"
+
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+unsigned markutil::HttpFileCache::defaultMaxEntries = 256;
+
+unsigned markutil::HttpFileCache::defaultRevalidate = 2;
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::HttpFileCache::Entry::Entry
+(
+    const std::string& file,
+    const std::string& mime
+)
+:
+    RefCount(),
+    fd_(::open(file.c_str(), O_RDONLY | O_CLOEXEC)),
+    size_(0),
+    mtime_(0),
+    dev_(0),
+    ino_(0),
+    mime_(mime),
+    etag_()
+{
+    struct stat st;
+    if (fd_ >= 0 && ::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        size_ = st.st_size;
+        mtime_ = st.st_mtime;
+        dev_ = st.st_dev;
+        ino_ = st.st_ino;
+
+        std::ostringstream oss;
+        oss << std::hex
+            << '"' << ino_ << '-' << size_ << '-' << mtime_ << '"';
+        etag_ = oss.str();
+    }
+    else if (fd_ >= 0)
+    {
+        // eg, a directory
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+
+markutil::HttpFileCache::HttpFileCache
+(
+    unsigned maxEntries,
+    unsigned revalidate
+)
+:
+    mutex_(),
+    slots_(),
+    maxEntries_(maxEntries ? maxEntries : 1),
+    revalidate_(revalidate),
+    clock_(0),
+    hits_(0),
+    misses_(0)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+markutil::HttpFileCache::Entry::~Entry()
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+}
+
+
+markutil::HttpFileCache::~HttpFileCache()
+{}
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void markutil::HttpFileCache::insert
+(
+    const std::string& file,
+    const Ptr& entry,
+    time_t now
+)
+{
+    SlotMap::iterator iter = slots_.find(file);
+
+    if (iter == slots_.end() && slots_.size() >= maxEntries_)
+    {
+        // evict the least recently used
+        SlotMap::iterator oldest = slots_.begin();
+        for
+        (
+            SlotMap::iterator it = slots_.begin();
+            it != slots_.end();
+            ++it
+        )
+        {
+            if (it->second.used < oldest->second.used)
+            {
+                oldest = it;
+            }
+        }
+        slots_.erase(oldest);
+    }
+
+    Slot& slot = slots_[file];
+    slot.entry = entry;
+    slot.checked = now;
+    slot.used = ++clock_;
+}
+
+
+markutil::HttpFileCache::Ptr
+markutil::HttpFileCache::find
+(
+    const std::string& file,
+    const std::string& name
+)
+{
+    const time_t now = time(0);
+    Ptr entry;
+    {
+        Mutex::Lock lock(mutex_);
+
+        SlotMap::iterator iter = slots_.find(file);
+        if (iter != slots_.end())
+        {
+            Slot& slot = iter->second;
+            slot.used = ++clock_;
+
+            if (now - slot.checked < time_t(revalidate_))
+            {
+                ++hits_;
+                return slot.entry;
+            }
+
+            entry = slot.entry;
+        }
+    }
+
+    // revalidate without holding the lock
+    if (entry.valid())
+    {
+        struct stat st;
+        if (::stat(file.c_str(), &st) == 0 && entry->unchanged(st))
+        {
+            Mutex::Lock lock(mutex_);
+
+            SlotMap::iterator iter = slots_.find(file);
+            if (iter != slots_.end() && iter->second.entry.get() == entry.get())
+            {
+                iter->second.checked = now;
+            }
+
+            ++hits_;
+            return entry;
+        }
+    }
+
+    // determine the MIME type from the extension
+    std::string mime;
+    {
+        const std::string::size_type dot = name.find_last_of("./");
+        if (dot != std::string::npos && name[dot] == '.')
+        {
+            mime = HttpCore::lookupMime(name.substr(dot+1));
+        }
+    }
+
+    if (mime.empty())
+    {
+        return Ptr();
+    }
+
+    entry = Ptr(new Entry(file, mime));
+
+    Mutex::Lock lock(mutex_);
+    ++misses_;
+
+    if (entry->valid())
+    {
+        insert(file, entry, now);
+        return entry;
+    }
+
+    // the file has gone
+    slots_.erase(file);
+    return Ptr();
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+bool markutil::HttpFileCache::Entry::unchanged(const struct stat& st) const
+{
+    return
+    (
+        st.st_dev == dev_
+     && st.st_ino == ino_
+     && st.st_size == size_
+     && st.st_mtime == mtime_
+    );
+}
+
+
+markutil::HttpFileCache::Ptr
+markutil::HttpFileCache::lookup(const std::string& file)
+{
+    return find(file, file);
+}
+
+
+markutil::HttpFileCache::Ptr
+markutil::HttpFileCache::lookupGzip(const std::string& file)
+{
+    Ptr entry = find(file + ".gz", file);
+    if (entry.valid())
+    {
+        Ptr orig = lookup(file);
+        if (!orig.valid() || entry->mtime() < orig->mtime())
+        {
+            return Ptr();
+        }
+    }
+
+    return entry;
+}
+
+
+void markutil::HttpFileCache::clear()
+{
+    Mutex::Lock lock(mutex_);
+    slots_.clear();
+}
+
+
+// ************************************************************************* //
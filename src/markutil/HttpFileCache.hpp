@@ -0,0 +1,286 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+
+Class
+    markutil::HttpFileCache
+
+Description
+    A bounded cache of open files for serving static documents, with
+    the information needed for their response headers (MIME type,
+    length, modification time, entity tag) determined once only.
+
+    An entry is revalidated with stat() when it is older than the
+    revalidation interval, and replaced if the file has changed.
+    Entries are reference-counted, so a file that is still being sent
+    remains open even if its entry has been replaced or evicted.
+    When the cache is full, the least recently used entry is evicted.
+
+    A precompressed sibling (eg, "file.css.gz" for "file.css") is
+    looked up as a separate entry with lookupGzip().
+
+    The cache is thread-safe.
+
+SourceFiles
+    HttpFileCache.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_HTTP_FILE_CACHE_H
+#define MARK_HTTP_FILE_CACHE_H
+
+#include "markutil/Mutex.hpp"
+#include "markutil/RefPtr.hpp"
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class HttpFileCache Declaration
+\*---------------------------------------------------------------------------*/
+
+class HttpFileCache
+{
+public:
+
+    //- An open file with its header information
+    class Entry
+    :
+        public RefCount
+    {
+        // Private data
+
+            //- The file descriptor
+            int fd_;
+
+            //- The file size
+            off_t size_;
+
+            //- The modification time
+            time_t mtime_;
+
+            //- The device and inode, to detect a replaced file
+            dev_t dev_;
+            ino_t ino_;
+
+            //- The MIME type
+            std::string mime_;
+
+            //- The entity tag, from the inode, size and modification time
+            std::string etag_;
+
+
+        // Private Member Functions
+
+            //- Disallow default bitwise copy construct
+            Entry(const Entry&);
+
+            //- Disallow default bitwise assignment
+            void operator=(const Entry&);
+
+
+    public:
+
+        // Constructors
+
+            //- Open the file, which is invalid unless it is a regular file
+            Entry(const std::string& file, const std::string& mime);
+
+
+        //- Destructor, closes the file
+        ~Entry();
+
+
+        // Member Functions
+
+            //- True if the file is open
+            bool valid() const
+            {
+                return fd_ >= 0;
+            }
+
+            //- True if the stat information still matches
+            bool unchanged(const struct stat&) const;
+
+            //- The file descriptor
+            int fd() const
+            {
+                return fd_;
+            }
+
+            //- The file size
+            off_t size() const
+            {
+                return size_;
+            }
+
+            //- The modification time
+            time_t mtime() const
+            {
+                return mtime_;
+            }
+
+            //- The MIME type
+            const std::string& mime() const
+            {
+                return mime_;
+            }
+
+            //- The entity tag
+            const std::string& etag() const
+            {
+                return etag_;
+            }
+    };
+
+    //- Shared read-only pointer to an entry
+    typedef RefPtr<const Entry> Ptr;
+
+
+private:
+
+    //- An entry with its bookkeeping
+    struct Slot
+    {
+        Ptr entry;
+        time_t checked;
+        unsigned long used;
+    };
+
+    typedef std::map<std::string, Slot> SlotMap;
+
+
+    // Private data
+
+        //- Protects all of the following
+        Mutex mutex_;
+
+        //- The entries by file name
+        SlotMap slots_;
+
+        //- The maximum number of entries
+        unsigned maxEntries_;
+
+        //- The revalidation interval (seconds)
+        unsigned revalidate_;
+
+        //- The use counter, for least recently used eviction
+        unsigned long clock_;
+
+        //- The number of lookups served from the cache
+        unsigned long hits_;
+
+        //- The number of lookups that opened the file
+        unsigned long misses_;
+
+
+    // Private Member Functions
+
+        //- Add or replace an entry, evicting one if required
+        void insert(const std::string& file, const Ptr&, time_t now);
+
+        //- The open file, with the MIME type determined from the
+        //  extension of the given name
+        Ptr find(const std::string& file, const std::string& name);
+
+        //- Disallow default bitwise copy construct
+        HttpFileCache(const HttpFileCache&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const HttpFileCache&);
+
+
+public:
+
+    // Static data members
+
+        //- The default maximum number of entries
+        static unsigned defaultMaxEntries;
+
+        //- The default revalidation interval (seconds)
+        static unsigned defaultRevalidate;
+
+
+    // Constructors
+
+        //- Construct empty
+        explicit HttpFileCache
+        (
+            unsigned maxEntries = defaultMaxEntries,
+            unsigned revalidate = defaultRevalidate
+        );
+
+
+    //- Destructor
+    ~HttpFileCache();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of lookups served from the cache
+            unsigned long hits() const
+            {
+                return hits_;
+            }
+
+            //- The number of lookups that opened the file
+            unsigned long misses() const
+            {
+                return misses_;
+            }
+
+            //- The open file with its header information, the MIME type
+            //  is determined from the extension of the file name.
+            //  Invalid if the MIME type is unknown or the file is not
+            //  a readable regular file
+            Ptr lookup(const std::string& file);
+
+            //- The open gzip-compressed sibling of the file (file.gz),
+            //  with the MIME type of the uncompressed file.
+            //  Invalid if there is none or it is older than the file
+            Ptr lookupGzip(const std::string& file);
+
+
+        // Edit
+
+            //- Close all files
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_HTTP_FILE_CACHE_H
+
+// ************************************************************************* //
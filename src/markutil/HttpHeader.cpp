@@ -32,47 +32,92 @@ License
 
 const char *markutil::HttpHeader::statusAsText(StatusCode code)
 {
-    // populate lookup table on the first call
-    static std::map<int, const char*> lookup;
-    static const char* notFound = "INVALID";
-
-    if (lookup.empty())
+    // a switch rather than a lookup table, which needs no initialization
+    switch (code)
     {
-        lookup[_200_OK] = "OK";
-        lookup[_301_MOVED_PERMANENTLY] = "Moved Permanently";
-        lookup[_302_FOUND] = "FOUND";
-        lookup[_304_NOT_MODIFIED] = "Not Modified";
-        lookup[_400_BAD_REQUEST] = "Bad request";
-        lookup[_401_UNAUTHORIZED] = "Unauthorized";
-        lookup[_403_FORBIDDEN] = "Forbidden";
-        lookup[_404_NOT_FOUND] = "Not Found";
-        lookup[_405_METHOD_NOT_ALLOWED] = "Method Not Allowed";
-        lookup[_500_INTERNAL_SERVER_ERROR] = "Internal Server Error";
-        lookup[_501_NOT_IMPLEMENTED] = "Not Implemented";
-        lookup[_503_SERVICE_UNAVAILABLE] = "Service Unavailable";
+        case _200_OK: return "OK";
+        case _301_MOVED_PERMANENTLY: return "Moved Permanently";
+        case _302_FOUND: return "FOUND";
+        case _304_NOT_MODIFIED: return "Not Modified";
+        case _400_BAD_REQUEST: return "Bad request";
+        case _401_UNAUTHORIZED: return "Unauthorized";
+        case _403_FORBIDDEN: return "Forbidden";
+        case _404_NOT_FOUND: return "Not Found";
+        case _405_METHOD_NOT_ALLOWED: return "Method Not Allowed";
+        case _500_INTERNAL_SERVER_ERROR: return "Internal Server Error";
+        case _501_NOT_IMPLEMENTED: return "Not Implemented";
+        case _503_SERVICE_UNAVAILABLE: return "Service Unavailable";
+        default: break;
     }
 
-    std::map<int, const char*>::const_iterator iter = lookup.find(code);
-    if (iter == lookup.end())
-    {
-        return notFound;
-    }
-    else
+    return "INVALID";
+}
+
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+//! \cond local scope
+
+// check for the entity tag in an If-None-Match list, or "*".
+// Uses the weak comparison (ignoring "W/"), as appropriate for GET/HEAD
+static bool matchesEtag(const std::string& list, const std::string& etag)
+{
+    const std::string tag =
+    (
+        etag.compare(0, 2, "W/") ? etag : etag.substr(2)
+    );
+
+    std::string::size_type beg = 0;
+    while (beg < list.size())
     {
-        return iter->second;
+        beg = list.find_first_not_of(" \t,", beg);
+        if (beg == std::string::npos)
+        {
+            break;
+        }
+
+        if (list[beg] == '*')
+        {
+            return true;
+        }
+
+        if (!list.compare(beg, 2, "W/"))
+        {
+            beg += 2;
+        }
+
+        // quoted-string, which cannot contain a comma
+        std::string::size_type end = list.find(',', beg);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+
+        std::string::size_type last = list.find_last_not_of(" \t", end-1);
+        if (last != std::string::npos && last >= beg)
+        {
+            if (!list.compare(beg, last - beg + 1, tag))
+            {
+                return true;
+            }
+        }
+
+        beg = end;
     }
+
+    return false;
 }
 
+//! \endcond
+
 
 // * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
 
 void markutil::HttpHeader::setDefaults()
 {
-    const std::string now = timestring();
-
+    // no Last-Modified: only the content knows when it was modified
     this->operator()
-        ("Date", now)
-        ("Last-Modified", now)
+        ("Date", timestring())
         ("Cache-Control", "no-cache")
         ("Content-Type", "text/html; charset=UTF-8");
 }
@@ -192,6 +237,47 @@ markutil::HttpHeader::status(StatusCode code)
 }
 
 
+bool markutil::HttpHeader::validate
+(
+    const std::string& etag,
+    time_t lastModified
+)
+{
+    if (!etag.empty())
+    {
+        this->operator()("ETag", etag);
+    }
+
+    if (lastModified)
+    {
+        this->operator()("Last-Modified", timestring(lastModified));
+    }
+
+    const std::string& noneMatch = request_["If-None-Match"];
+    const std::string& modSince = request_["If-Modified-Since"];
+
+    bool current = false;
+
+    // If-None-Match takes precedence over If-Modified-Since
+    if (!noneMatch.empty())
+    {
+        current = !etag.empty() && matchesEtag(noneMatch, etag);
+    }
+    else if (!modSince.empty() && lastModified)
+    {
+        const time_t since = parseTime(modSince);
+        current = (since && lastModified <= since);
+    }
+
+    if (current)
+    {
+        status_ = _304_NOT_MODIFIED;
+    }
+
+    return current;
+}
+
+
 std::ostream& markutil::HttpHeader::htmlBeg(std::ostream& os) const
 {
     os  << "<html><head><title>"
@@ -230,7 +316,9 @@ std::ostream& markutil::HttpHeader::print
     bool withHtml
 ) const
 {
-    os  << "HTTP/1.0 " << status_ << " " << statusAsText() << "\r\n";
+    // answer HTTP/1.1 requests in kind
+    os  << (request_.http11() ? "HTTP/1.1 " : "HTTP/1.0 ")
+        << status_ << " " << statusAsText() << "\r\n";
     this->HttpCore::print(os);
     os  << "\r\n";
 
@@ -164,6 +164,12 @@ public:
             //- Alter the status code
             HttpHeader& status(StatusCode code);
 
+            //- Set the ETag and Last-Modified validators (if non-empty)
+            //  and check them against the conditional headers of the
+            //  request (If-None-Match, If-Modified-Since).
+            //  \return true, with status 304, if the client copy is current
+            bool validate(const std::string& etag, time_t lastModified);
+
 
         // Write
 
@@ -27,6 +27,8 @@ License
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <pthread.h>
+#include <strings.h>
 
 
 // * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
@@ -34,6 +36,9 @@ License
 
 markutil::HttpRequest::MethodLookupType markutil::HttpRequest::methodLookup_;
 
+// local scope
+static pthread_once_t lookupOnce_ = PTHREAD_ONCE_INIT;
+
 
 // * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
 
@@ -63,28 +68,124 @@ static std::string getToken(const std::string& buf, size_t& beg)
 }
 
 
-// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+// local scope
+// check for a token in a comma-separated header value, ignoring case
+static bool hasToken(const std::string& value, const char* token)
+{
+    const size_t len = strlen(token);
 
-void markutil::HttpRequest::populateLookup()
+    size_t beg = 0;
+    while (beg < value.size())
+    {
+        beg = value.find_first_not_of(" \t,", beg);
+        if (beg == std::string::npos)
+        {
+            break;
+        }
+
+        size_t end = value.find_first_of(" \t,", beg);
+        if (end == std::string::npos)
+        {
+            end = value.size();
+        }
+
+        if
+        (
+            end - beg == len
+         && strncasecmp(value.c_str() + beg, token, len) == 0
+        )
+        {
+            return true;
+        }
+
+        beg = end;
+    }
+
+    return false;
+}
+
+
+// the quality value of a content-coding in an Accept-Encoding value,
+// or of "*" if the coding is not listed. -1 if neither is listed
+static double codingQuality(const std::string& value, const char* coding)
 {
-    if (methodLookup_.empty())
+    const size_t len = strlen(coding);
+    double anyQ = -1;
+
+    size_t beg = 0;
+    while (beg < value.size())
     {
-        methodLookup_["OPTIONS"] = OPTIONS;
-        methodLookup_["GET"] = GET;
-        methodLookup_["HEAD"] =  HEAD;
-        methodLookup_["POST"] = POST;
-        methodLookup_["PUT"] = PUT;
-        methodLookup_["DELETE"] = DELETE;
-        methodLookup_["TRACE"] = TRACE;
-        methodLookup_["CONNECT"] = CONNECT;
+        size_t end = value.find(',', beg);
+        if (end == std::string::npos)
+        {
+            end = value.size();
+        }
+
+        // the coding, optionally followed by ";q=value"
+        const std::string item = value.substr(beg, end - beg);
+        beg = end + 1;
+
+        const size_t nameBeg = item.find_first_not_of(" \t");
+        if (nameBeg == std::string::npos)
+        {
+            continue;
+        }
+
+        size_t nameEnd = item.find_first_of(" \t;", nameBeg);
+        if (nameEnd == std::string::npos)
+        {
+            nameEnd = item.size();
+        }
+
+        double q = 1;
+        const size_t param = item.find(';', nameEnd);
+        if (param != std::string::npos)
+        {
+            const size_t qpos = item.find_first_not_of(" \t", param + 1);
+            if
+            (
+                qpos != std::string::npos
+             && strncasecmp(item.c_str() + qpos, "q=", 2) == 0
+            )
+            {
+                q = strtod(item.c_str() + qpos + 2, NULL);
+            }
+        }
+
+        const std::string name = item.substr(nameBeg, nameEnd - nameBeg);
+        if (name.size() == len && strncasecmp(name.c_str(), coding, len) == 0)
+        {
+            return q;
+        }
+        else if (name == "*")
+        {
+            anyQ = q;
+        }
     }
+
+    return anyQ;
+}
+
+
+// * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
+
+void markutil::HttpRequest::populateLookup()
+{
+    methodLookup_["OPTIONS"] = OPTIONS;
+    methodLookup_["GET"] = GET;
+    methodLookup_["HEAD"] =  HEAD;
+    methodLookup_["POST"] = POST;
+    methodLookup_["PUT"] = PUT;
+    methodLookup_["DELETE"] = DELETE;
+    methodLookup_["TRACE"] = TRACE;
+    methodLookup_["CONNECT"] = CONNECT;
 }
 
 
 markutil::HttpRequest::MethodType
 markutil::HttpRequest::lookupMethod(const std::string& method)
 {
-    populateLookup();
+    ::pthread_once(&lookupOnce_, populateLookup);
 
     if (method.empty())
     {
@@ -105,7 +206,7 @@ markutil::HttpRequest::lookupMethod(const std::string& method)
 
 std::string markutil::HttpRequest::lookupMethod(MethodType method)
 {
-    populateLookup();
+    ::pthread_once(&lookupOnce_, populateLookup);
 
     for
     (
@@ -261,6 +362,46 @@ const std::string& markutil::HttpRequest::protocol() const
 }
 
 
+bool markutil::HttpRequest::http11() const
+{
+    return httpver_ == "HTTP/1.1";
+}
+
+
+bool markutil::HttpRequest::keepAlive() const
+{
+    const std::string& conn = this->operator[]("Connection");
+
+    if (http11())
+    {
+        return !hasToken(conn, "close");
+    }
+    else
+    {
+        return hasToken(conn, "keep-alive");
+    }
+}
+
+
+bool markutil::HttpRequest::acceptsGzip() const
+{
+    const std::string& accept = this->operator[]("Accept-Encoding");
+
+    if (accept.empty())
+    {
+        return false;
+    }
+
+    double q = codingQuality(accept, "gzip");
+    if (q < 0)
+    {
+        q = codingQuality(accept, "x-gzip");
+    }
+
+    return q > 0;
+}
+
+
 std::string markutil::HttpRequest::requestURI() const
 {
     std::string uri;
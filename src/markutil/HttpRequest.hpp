@@ -100,7 +100,7 @@ private:
 
     // Private Member Functions
 
-        //- populate the lookup table
+        //- populate the lookup table, called once only
         static void populateLookup();
 
         //- Lookup enumerated method-type from string content
@@ -159,6 +159,18 @@ public:
             //! \brief Return the protocol (eg, HTTP/1.0) as a string
             const std::string& protocol() const;
 
+            //! \brief True if the protocol is HTTP/1.1
+            bool http11() const;
+
+            //! \brief True if the client wants a persistent connection:
+            //  the HTTP/1.1 default unless "Connection: close",
+            //  for HTTP/1.0 only with "Connection: keep-alive"
+            bool keepAlive() const;
+
+            //! \brief True if the client accepts a gzip content-coding,
+            //  by name or as "*", with a non-zero quality value
+            bool acceptsGzip() const;
+
             //! \brief Return the Request-URI
             std::string requestURI() const;
 
@@ -0,0 +1,178 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/HttpResponseCache.hpp"
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+size_t markutil::HttpResponseCache::defaultMaxBytes = 64*1024*1024;
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::HttpResponseCache::HttpResponseCache(size_t maxBytes)
+:
+    mutex_(),
+    slots_(),
+    usage_(),
+    generation_(0),
+    bytes_(0),
+    maxBytes_(maxBytes),
+    hits_(0),
+    misses_(0)
+{}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+markutil::HttpResponseCache::~HttpResponseCache()
+{}
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+bool markutil::HttpResponseCache::advance(unsigned long generation)
+{
+    if (generation < generation_)
+    {
+        return false;
+    }
+
+    if (generation > generation_)
+    {
+        slots_.clear();
+        usage_.clear();
+        bytes_ = 0;
+        generation_ = generation;
+    }
+
+    return true;
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+unsigned long markutil::HttpResponseCache::hits() const
+{
+    Mutex::Lock lock(mutex_);
+
+    return hits_;
+}
+
+
+unsigned long markutil::HttpResponseCache::misses() const
+{
+    Mutex::Lock lock(mutex_);
+
+    return misses_;
+}
+
+
+size_t markutil::HttpResponseCache::bytes() const
+{
+    Mutex::Lock lock(mutex_);
+
+    return bytes_;
+}
+
+
+markutil::HttpResponseCache::Ptr
+markutil::HttpResponseCache::lookup
+(
+    const std::string& key,
+    unsigned long generation
+)
+{
+    Mutex::Lock lock(mutex_);
+
+    if (advance(generation))
+    {
+        SlotMap::iterator iter = slots_.find(key);
+        if (iter != slots_.end())
+        {
+            Slot& slot = iter->second;
+            usage_.splice(usage_.begin(), usage_, slot.usage);
+
+            ++hits_;
+            return slot.body;
+        }
+    }
+
+    ++misses_;
+    return Ptr();
+}
+
+
+void markutil::HttpResponseCache::insert
+(
+    const std::string& key,
+    unsigned long generation,
+    const Ptr& body
+)
+{
+    if (!body.valid() || body->size() > maxBytes_)
+    {
+        return;
+    }
+
+    Mutex::Lock lock(mutex_);
+
+    if (!advance(generation))
+    {
+        return;
+    }
+
+    SlotMap::iterator iter = slots_.find(key);
+    if (iter != slots_.end())
+    {
+        // rendered concurrently by another request
+        bytes_ -= iter->second.body->size();
+        usage_.erase(iter->second.usage);
+        slots_.erase(iter);
+    }
+
+    // evict the least recently used
+    while (!usage_.empty() && bytes_ + body->size() > maxBytes_)
+    {
+        SlotMap::iterator oldest = slots_.find(usage_.back());
+        bytes_ -= oldest->second.body->size();
+        slots_.erase(oldest);
+        usage_.pop_back();
+    }
+
+    Slot& slot = slots_[key];
+    slot.body = body;
+    slot.usage = usage_.insert(usage_.begin(), key);
+    bytes_ += body->size();
+}
+
+
+void markutil::HttpResponseCache::clear()
+{
+    Mutex::Lock lock(mutex_);
+    slots_.clear();
+    usage_.clear();
+    bytes_ = 0;
+}
+
+
+// ************************************************************************* //
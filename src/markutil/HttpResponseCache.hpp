@@ -0,0 +1,244 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+
+Class
+    markutil::HttpResponseCache
+
+Description
+    A byte-bounded cache of rendered response bodies, keyed by the route
+    (path and normalized query) and valid for one generation of the
+    underlying data only.
+
+    The first request for a route in a generation renders the body and
+    inserts it, subsequent requests send the same body without rendering
+    it again. A lookup or insert with a newer generation discards all
+    bodies of the older generations. When the cache is over its byte
+    limit, the least recently used bodies are evicted. Bodies are
+    reference-counted, so a body that is still being sent remains valid
+    even if it has been evicted.
+
+    The cache is thread-safe.
+
+SourceFiles
+    HttpResponseCache.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_HTTP_RESPONSE_CACHE_H
+#define MARK_HTTP_RESPONSE_CACHE_H
+
+#include "markutil/Mutex.hpp"
+#include "markutil/RefPtr.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+/*---------------------------------------------------------------------------*\
+                      Class HttpResponseCache Declaration
+\*---------------------------------------------------------------------------*/
+
+class HttpResponseCache
+{
+public:
+
+    //- A rendered response body
+    class Body
+    :
+        public RefCount
+    {
+        // Private data
+
+            //- The content
+            std::string content_;
+
+
+        // Private Member Functions
+
+            //- Disallow default bitwise copy construct
+            Body(const Body&);
+
+            //- Disallow default bitwise assignment
+            void operator=(const Body&);
+
+
+    public:
+
+        // Constructors
+
+            //- Construct by taking the content, leaving the string empty
+            explicit Body(std::string& content)
+            :
+                RefCount(),
+                content_()
+            {
+                content_.swap(content);
+            }
+
+
+        // Member Functions
+
+            //- The content
+            const std::string& content() const
+            {
+                return content_;
+            }
+
+            //- The content size
+            size_t size() const
+            {
+                return content_.size();
+            }
+    };
+
+    //- Shared read-only pointer to a body
+    typedef RefPtr<const Body> Ptr;
+
+
+private:
+
+    //- Route keys, most recently used first
+    typedef std::list<std::string> UsageList;
+
+    //- A body with its position in the usage list
+    struct Slot
+    {
+        Ptr body;
+        UsageList::iterator usage;
+    };
+
+    typedef std::map<std::string, Slot> SlotMap;
+
+
+    // Private data
+
+        //- Protects all of the following
+        mutable Mutex mutex_;
+
+        //- The bodies by route key
+        SlotMap slots_;
+
+        //- The route keys in order of use
+        UsageList usage_;
+
+        //- The generation of the cached bodies
+        unsigned long generation_;
+
+        //- The total size of the cached bodies
+        size_t bytes_;
+
+        //- The maximum total size of the cached bodies
+        size_t maxBytes_;
+
+        //- The number of lookups served from the cache
+        unsigned long hits_;
+
+        //- The number of lookups that required rendering
+        unsigned long misses_;
+
+
+    // Private Member Functions
+
+        //- Discard the bodies if the generation is newer.
+        //  \return false if the generation is older
+        bool advance(unsigned long generation);
+
+        //- Disallow default bitwise copy construct
+        HttpResponseCache(const HttpResponseCache&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const HttpResponseCache&);
+
+
+public:
+
+    // Static data members
+
+        //- The default maximum total size of the cached bodies
+        static size_t defaultMaxBytes;
+
+
+    // Constructors
+
+        //- Construct empty
+        explicit HttpResponseCache(size_t maxBytes = defaultMaxBytes);
+
+
+    //- Destructor
+    ~HttpResponseCache();
+
+
+    // Member Functions
+
+        // Access
+
+            //- The number of lookups served from the cache
+            unsigned long hits() const;
+
+            //- The number of lookups that required rendering
+            unsigned long misses() const;
+
+            //- The total size of the cached bodies
+            size_t bytes() const;
+
+            //- The maximum total size of the cached bodies
+            size_t maxBytes() const
+            {
+                return maxBytes_;
+            }
+
+            //- The body for the route in the given generation,
+            //  invalid if it has not been rendered yet
+            Ptr lookup(const std::string& key, unsigned long generation);
+
+
+        // Edit
+
+            //- Add the body rendered for the route in the given generation,
+            //  unless a newer generation has been seen meanwhile or it is
+            //  larger than the cache itself
+            void insert
+            (
+                const std::string& key,
+                unsigned long generation,
+                const Ptr&
+            );
+
+            //- Discard all bodies
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_HTTP_RESPONSE_CACHE_H
+
+// ************************************************************************* //
@@ -20,20 +20,34 @@ License
 \*---------------------------------------------------------------------------*/
 
 #include "markutil/HttpServer.hpp"
+#include "markutil/HttpConnection.hpp"
 #include "markutil/HttpHeader.hpp"
 #include "markutil/HttpRequest.hpp"
+#include "markutil/Mutex.hpp"
+#include "markutil/SocketStream.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <map>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <signal.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/select.h>
 #include <sys/wait.h>
 
-#include "fdstream/fdstream.hpp"
-
 
 // * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
 
@@ -45,9 +59,169 @@ std::string markutil::HttpServer::defaultName = "HttpServer";
 
 std::string markutil::HttpServer::defaultCgiPrefix = "/cgi-bin";
 
-// local scope
+unsigned markutil::HttpServer::defaultThreads = 8;
+
+unsigned markutil::HttpServer::defaultProcesses = 4;
+
+// local scope - the size of the buffers used for copying
 static const unsigned BufSize = 8096;
-static char buffer[BufSize];
+
+
+//! \cond local scope
+
+// connections accepted but not yet handed to a worker thread
+struct ConnectionQueue
+{
+    markutil::Mutex mutex;
+    markutil::Condition notEmpty;
+    markutil::Condition notFull;
+    std::deque<int> fds;
+    unsigned maxSize;
+    markutil::HttpServer* server;
+};
+
+
+// wait at most the given number of seconds for a socket to become
+// readable (POLLIN) or writable (POLLOUT)
+static bool waitFor(int sockfd, short events, unsigned seconds)
+{
+    struct pollfd pfd;
+    pfd.fd = sockfd;
+    pfd.events = events;
+    pfd.revents = 0;
+
+    int ready;
+    do
+    {
+        ready = ::poll(&pfd, 1, 1000*seconds);
+    }
+    while (ready < 0 && errno == EINTR);
+
+    return ready > 0;
+}
+
+
+// the Content-Length to complete the header of a response with,
+// unless it already has one. The body may continue with a file.
+// Without a body (HEAD, 304) there is nothing to count, and anything
+// after the header is dropped (len).
+// Return false if the response has no recognizable header
+static bool frameResponse
+(
+    const char* data,
+    size_t& len,
+    size_t fileLen,
+    bool withBody,
+    size_t& insertAt,
+    std::string& insert
+)
+{
+    const char* const sep = "\r\n\r\n";
+    const char* const end = std::search(data, data + len, sep, sep + 4);
+
+    insertAt = len;
+    insert.clear();
+
+    if (end == data + len)
+    {
+        return false;
+    }
+
+    const size_t headerEnd = end - data;
+
+    if (!withBody)
+    {
+        len = insertAt = headerEnd + 4;
+    }
+    else if
+    (
+        std::string(data, headerEnd).find("\r\nContent-Length:")
+     == std::string::npos
+    )
+    {
+        std::ostringstream oss;
+        oss << "\r\nContent-Length: " << (len - headerEnd - 4 + fileLen);
+
+        insertAt = headerEnd;
+        insert = oss.str();
+    }
+
+    return true;
+}
+
+
+// send the content of a cached file: with sendfile() on a socket,
+// otherwise copy blockwise - last block may be smaller
+static void sendFile
+(
+    std::ostream& os,
+    const markutil::HttpFileCache::Entry& entry
+)
+{
+    markutil::SocketStream* sock = dynamic_cast<markutil::SocketStream*>(&os);
+
+    if (sock)
+    {
+        sock->sendfile(entry.fd(), 0, entry.size(), &entry);
+        return;
+    }
+
+    char buffer[BufSize];
+    off_t offset = 0;
+    ssize_t nbyte;
+    while ((nbyte = ::pread(entry.fd(), buffer, BufSize, offset)) > 0)
+    {
+        os.write(buffer, nbyte);
+        offset += nbyte;
+    }
+}
+
+
+// the connections of the event-driven servers
+typedef std::map<int, markutil::HttpConnection> ConnectionMap;
+
+
+// edge-triggered: accept everything that is pending on the
+// (non-blocking) listening socket and monitor it for input and output
+static void acceptAll(int listenFd, int epollFd, ConnectionMap& connections)
+{
+    struct epoll_event ev;
+
+    while (true)
+    {
+        const int connectFd = ::accept4
+        (
+            listenFd,
+            NULL,
+            NULL,
+            SOCK_NONBLOCK | SOCK_CLOEXEC
+        );
+
+        if (connectFd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            break;  // EAGAIN, or out of descriptors etc.
+        }
+
+        // edge-triggered: writable only signals room after a full socket
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = connectFd;
+
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, connectFd, &ev))
+        {
+            ::close(connectFd);
+        }
+        else
+        {
+            connections[connectFd] = markutil::HttpConnection(connectFd);
+        }
+    }
+}
+
+//! \endcond
 
 
 // * * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * //
@@ -109,7 +283,8 @@ bool markutil::HttpServer::setPath
         else
         {
             // resolve relative -> abs path
-            if (!::getcwd(buffer, BufSize))
+            char buffer[PATH_MAX];
+            if (!::getcwd(buffer, sizeof(buffer)))
             {
                 return false;
             }
@@ -131,34 +306,193 @@ bool markutil::HttpServer::setPath
 
 int markutil::HttpServer::dispatch(int sockfd)
 {
-    HttpHeader head;
-    head("Server", this->name());
+    HttpConnection conn(sockfd);
+
+    // non-blocking, so that every wait on the client - for a request
+    // or for room to send the reply - is limited by a timeout
+    this->setNonBlocking(sockfd);
+
+    bool more = true;
+    while (true)
+    {
+        // reply to whatever arrived, even if the client closed after it
+        const bool open = this->serve(conn);
+
+        if (!conn.output().empty())
+        {
+            // a client that stops reading is dropped
+            if
+            (
+                !waitFor(sockfd, POLLOUT, HttpConnection::idleTimeout)
+             || !conn.output().flush()
+            )
+            {
+                break;
+            }
+
+            continue;
+        }
 
-    // fill with request and fill host/peer information
-    head.request().readHeader(sockfd);
+        // a client gets longer to send its first request
+        if
+        (
+            !open || !more || conn.overflow()
+         || !waitFor
+            (
+                sockfd,
+                POLLIN,
+                conn.requests()
+              ? HttpConnection::keepAliveTimeout
+              : HttpConnection::idleTimeout
+            )
+        )
+        {
+            break;
+        }
+
+        more = conn.fill(true);
+    }
+
+    return 0;
+}
 
-    // fill host/peer information
-    head.request().socketInfo().setInfo(sockfd);
 
+bool markutil::HttpServer::dispatch(HttpConnection& conn, HttpHeader& head)
+{
+    head("Server", this->name());
 
-    boost::fdostream os(sockfd);
+    const int sockfd = conn.fd();
+
+    SocketStream os(sockfd);
+    os.backlog(&conn.output());
 
     // check for cgi-bin
     if (this->isCgi(head))
     {
+        // the cgi output is passed through as-is, so end with it
+        head("Connection", "close");
+
+        this->setBlocking(sockfd);
+
         if (this->cgiOkay(os, head))
         {
             // serve cgi
-            return this->cgi(sockfd, head);
+            os.flush();
+            this->cgi(sockfd, head);
         }
+
+        return false;
     }
-    else
+
+    // serve normal document, held until its length is known
+    os.hold();
+    this->reply(os, head);
+
+    size_t len = os.nPending();
+    size_t insertAt;
+    std::string insert;
+
+    const bool framed = frameResponse
+    (
+        os.pending(),
+        len,
+        os.nPendingTail(),
+        (
+            head.request().type() != HttpRequest::HEAD
+         && head.status() != HttpHeader::_304_NOT_MODIFIED
+        ),
+        insertAt,
+        insert
+    );
+
+    // send the header, the Content-Length and the body in one go
+    const bool ok = os.sendHeld(len, insertAt, insert);
+
+    return ok && framed && head["Connection"] == "keep-alive";
+}
+
+
+bool markutil::HttpServer::serve(HttpConnection& conn)
+{
+    // pipelined requests wait for the room to reply,
+    // and are dropped once the connection is finished
+    while (!conn.finished() && conn.hasRequest() && conn.output().empty())
+    {
+        HttpHeader head;
+        conn.nextRequest(head.request());
+
+        const HttpRequest& req = head.request();
+
+        // a request body is never read, and would otherwise be taken
+        // for the next request
+        const bool keepAlive =
+        (
+            req.keepAlive()
+         && conn.persistent()
+         && req["Content-Length"].empty()
+         && req["Transfer-Encoding"].empty()
+        );
+
+        head("Connection", keepAlive ? "keep-alive" : "close");
+
+        const bool keep = this->dispatch(conn, head);
+        conn.touch();
+
+        if (!keep)
+        {
+            conn.finish();
+        }
+    }
+
+    return !conn.finished();
+}
+
+
+void* markutil::HttpServer::worker(void* arg)
+{
+    ConnectionQueue& queue = *static_cast<ConnectionQueue*>(arg);
+
+    while (true)
+    {
+        int sockfd;
+        {
+            markutil::Mutex::Lock lock(queue.mutex);
+            while (queue.fds.empty())
+            {
+                queue.notEmpty.wait(queue.mutex);
+            }
+
+            sockfd = queue.fds.front();
+            queue.fds.pop_front();
+            queue.notFull.signal();
+        }
+
+        queue.server->dispatch(sockfd);
+        ::close(sockfd);
+    }
+
+    return NULL;
+}
+
+
+int markutil::HttpServer::spawn()
+{
+    const pid_t master = ::getpid();
+
+    const int pid = ::fork();
+    if (pid)
+    {
+        return pid;
+    }
+
+    // worker: do not outlive the master
+    ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+    if (::getppid() != master)
     {
-        // serve normal document
-        return this->reply(os, head);
+        ::_exit(0);
     }
 
-    return 1;
+    return 0;
 }
 
 
@@ -285,7 +619,7 @@ std::string markutil::HttpServer::setCgiEnv(HttpHeader& head) const
 
     //
     // REMOTE_ADDR, REMOTE_PORT from socket information
-    // and REMOTE_HOST from gethostbyaddr
+    // and REMOTE_HOST from a reverse lookup
     //
     setenv("REMOTE_ADDR", req.socketInfo().peerAddr().c_str(), 1);
     setenv("REMOTE_HOST", req.socketInfo().peerName().c_str(), 1);
@@ -293,7 +627,7 @@ std::string markutil::HttpServer::setCgiEnv(HttpHeader& head) const
 
     //
     // SERVER_ADDR, SERVER_PORT from socket information
-    // and SERVER_NAME from gethostbyaddr
+    // and SERVER_NAME from a reverse lookup
     //
     setenv("SERVER_ADDR", req.socketInfo().hostAddr().c_str(), 1);
     setenv("SERVER_NAME", req.socketInfo().hostName().c_str(), 1);
@@ -408,7 +742,10 @@ markutil::HttpServer::HttpServer(unsigned short port, bool reuse)
     root_(defaultRoot),
     name_(defaultName),
     cgiPrefix_(defaultCgiPrefix),
-    cgibin_()
+    cgibin_(),
+    threads_(defaultThreads),
+    processes_(defaultProcesses),
+    files_()
 {
     if (port)
     {
@@ -427,7 +764,10 @@ markutil::HttpServer::HttpServer(const std::string& port, bool reuse)
     root_(defaultRoot),
     name_(defaultName),
     cgiPrefix_(defaultCgiPrefix),
-    cgibin_()
+    cgibin_(),
+    threads_(defaultThreads),
+    processes_(defaultProcesses),
+    files_()
 {
     if (port.empty() || port[0] == '0')
     {
@@ -448,7 +788,10 @@ markutil::HttpServer::HttpServer(const char* port, bool reuse)
     root_(defaultRoot),
     name_(defaultName),
     cgiPrefix_(defaultCgiPrefix),
-    cgibin_()
+    cgibin_(),
+    threads_(defaultThreads),
+    processes_(defaultProcesses),
+    files_()
 {
     if (!port || !*port || port[0] == '0')
     {
@@ -523,6 +866,42 @@ bool markutil::HttpServer::cgiPrefix(const std::string& path)
 }
 
 
+unsigned markutil::HttpServer::threads() const
+{
+    return threads_;
+}
+
+
+bool markutil::HttpServer::threads(unsigned n)
+{
+    if (n)
+    {
+        threads_ = n;
+        return true;
+    }
+
+    return false;
+}
+
+
+unsigned markutil::HttpServer::processes() const
+{
+    return processes_;
+}
+
+
+bool markutil::HttpServer::processes(unsigned n)
+{
+    if (n)
+    {
+        processes_ = n;
+        return true;
+    }
+
+    return false;
+}
+
+
 int markutil::HttpServer::run_fork()
 {
     this->bind(port_);   // only if not already bound
@@ -569,40 +948,82 @@ int markutil::HttpServer::run_select()
     this->bind(port_);       // only if not already bound
     this->listen();          // only if not already listening
 
-    const int listenFd = this->sock();
-
-    fd_set monitorFds;
+    // a vanished client must not terminate the entire server
+    ::signal(SIGPIPE, SIG_IGN);
 
-    // add listener to the monitored file descriptors
-    FD_ZERO(&monitorFds);
-    FD_SET(listenFd, &monitorFds);
+    const int listenFd = this->sock();
 
-    // track the largest file descriptor
-    int maxFd = listenFd;  // currently it is the listener
+    // the open connections
+    ConnectionMap connections;
 
     while (true)
     {
-        // copy in monitored descriptors
-        fd_set readFds = monitorFds;
+        // monitor the listener, the connections with output waiting for
+        // room and the others for their requests
+        fd_set readFds;
+        fd_set writeFds;
+        FD_ZERO(&readFds);
+        FD_ZERO(&writeFds);
+
+        FD_SET(listenFd, &readFds);
+
+        // track the largest file descriptor
+        int maxFd = listenFd;
 
-        int nRead = ::select
+        for
+        (
+            ConnectionMap::iterator iter = connections.begin();
+            iter != connections.end();
+            ++iter
+        )
+        {
+            const int sockfd = iter->first;
+
+            if (!iter->second.output().empty())
+            {
+                FD_SET(sockfd, &writeFds);
+            }
+            else
+            {
+                FD_SET(sockfd, &readFds);
+            }
+
+            if (maxFd < sockfd)
+            {
+                maxFd = sockfd;
+            }
+        }
+
+        // wake up periodically to drop idle connections
+        struct timeval timeout;
+        timeout.tv_sec = 1;
+        timeout.tv_usec = 0;
+
+        int nReady = ::select
         (
             maxFd+1,
             &readFds,    // readfds
-            NULL,        // writefds
+            &writeFds,   // writefds
             NULL,        // exceptfds
-            NULL         // timeout - block until something is there
+            &timeout
         );
 
+        // the connections to be closed
+        std::vector<int> closing;
+
         // run through the existing connections looking for data to read
+        // or room to write
         for
         (
             int nHandled = 0, sockfd = 0;
-            nHandled < nRead && sockfd <= maxFd;
+            nHandled < nReady && sockfd <= maxFd;
             ++sockfd
         )
         {
-            if (FD_ISSET(sockfd, &readFds))
+            const bool readable = FD_ISSET(sockfd, &readFds);
+            const bool writable = FD_ISSET(sockfd, &writeFds);
+
+            if (readable || writable)
             {
                 ++nHandled;  // abort scanning ASAP
             }
@@ -616,36 +1037,321 @@ int markutil::HttpServer::run_select()
                 // handle new connection
                 const int connectFd = this->accept();
 
-                if (connectFd >= 0)
+                if (connectFd >= FD_SETSIZE)
+                {
+                    ::close(connectFd);     // cannot be monitored
+                }
+                else if (connectFd >= 0)
                 {
                     this->setNonBlocking(connectFd);
-                    FD_SET(connectFd, &monitorFds);
+                    connections[connectFd] = HttpConnection(connectFd);
+                }
+                continue;
+            }
 
-                    if (maxFd < connectFd)
-                    {
-                        maxFd = connectFd;
-                    }
+            HttpConnection& conn = connections[sockfd];
+
+            if (writable)
+            {
+                // write what the socket did not take before
+                conn.touch();
+                if (!conn.output().flush())
+                {
+                    closing.push_back(sockfd);
+                    continue;
                 }
             }
-            else
+
+            const bool ok = !readable || conn.fill();
+
+            // reply to every complete request, and keep the connection
+            // for more, for the rest of the header or for the rest of
+            // the replies
+            if (!this->serve(conn) || !ok || conn.overflow())
+            {
+                conn.finish();
+            }
+
+            if (conn.done())
+            {
+                closing.push_back(sockfd);
+            }
+        }
+
+        // drop connections that are idle for too long
+        const time_t now = time(0);
+        for
+        (
+            ConnectionMap::const_iterator iter = connections.begin();
+            iter != connections.end();
+            ++iter
+        )
+        {
+            if (iter->second.expired(now))
+            {
+                closing.push_back(iter->first);
+            }
+        }
+
+        for (unsigned closeI = 0; closeI < closing.size(); ++closeI)
+        {
+            const int sockfd = closing[closeI];
+            if (connections.erase(sockfd))
+            {
+                ::close(sockfd);
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+int markutil::HttpServer::run_epoll()
+{
+    this->setNonBlocking(this->sock());  // make socket non-blocking
+    this->bind(port_);       // only if not already bound
+    this->listen();          // only if not already listening
+
+    // a vanished client must not terminate the entire server
+    ::signal(SIGPIPE, SIG_IGN);
+
+    const int listenFd = this->sock();
+    const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        error_ = "epoll_create failed";
+        return 1;
+    }
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = listenFd;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev) < 0)
+    {
+        error_ = "epoll_ctl failed for listening socket";
+        ::close(epollFd);
+        return 1;
+    }
+
+    // the connections being read
+    ConnectionMap connections;
+
+    const int maxEvents = 256;
+    struct epoll_event events[maxEvents];
+
+    time_t lastReaped = time(0);
+
+    while (true)
+    {
+        // wake up periodically to drop idle connections
+        const int nEvents = ::epoll_wait(epollFd, events, maxEvents, 1000);
+
+        for (int eventI = 0; eventI < nEvents; ++eventI)
+        {
+            const int sockfd = events[eventI].data.fd;
+
+            if (sockfd == listenFd)
+            {
+                acceptAll(listenFd, epollFd, connections);
+                continue;
+            }
+
+            ConnectionMap::iterator iter = connections.find(sockfd);
+            if (iter == connections.end())
+            {
+                continue;
+            }
+
+            HttpConnection& conn = iter->second;
+
+            // edge-triggered: write what the socket did not take before,
+            // then read everything available
+            bool ok = !(events[eventI].events & EPOLLERR);
+
+            if (ok && !conn.output().empty())
             {
-                FD_CLR(sockfd, &monitorFds);    // remove from monitored descriptors
+                ok = conn.output().flush();
+                conn.touch();
+            }
 
-                // maxFd may need adjustment
-                if (maxFd == sockfd)
+            if (ok)
+            {
+                // reply to every complete request, and keep the connection
+                // for more, for the rest of the header or for the rest of
+                // the replies. Input left on the socket at the maximum
+                // header size is not reported again, so it is read once
+                // the requests before it are answered
+                do
                 {
-                    for (int i = maxFd; i >= listenFd; --i)
+                    const bool more = conn.fill();
+
+                    if (!this->serve(conn) || !more || conn.overflow())
                     {
-                        if (FD_ISSET(i, &monitorFds))
-                        {
-                            maxFd = i;
-                            break;
-                        }
+                        conn.finish();
                     }
                 }
+                while
+                (
+                    conn.capped()
+                 && !conn.finished()
+                 && conn.output().empty()
+                );
+
+                if (!conn.done())
+                {
+                    continue;
+                }
+            }
 
-                this->dispatch(sockfd);
-                ::close(sockfd);
+            ::epoll_ctl(epollFd, EPOLL_CTL_DEL, sockfd, NULL);
+            ::close(sockfd);
+            connections.erase(iter);
+        }
+
+        // drop connections that are idle for too long
+        const time_t now = time(0);
+        if (now > lastReaped)
+        {
+            lastReaped = now;
+
+            ConnectionMap::iterator iter = connections.begin();
+            while (iter != connections.end())
+            {
+                if (iter->second.expired(now))
+                {
+                    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, iter->first, NULL);
+                    ::close(iter->first);
+                    connections.erase(iter++);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+    }
+
+    ::close(epollFd);
+
+    return 0;
+}
+
+
+int markutil::HttpServer::run_threadpool()
+{
+    this->bind(port_);   // only if not already bound
+    this->listen();      // only if not already listening
+
+    // a vanished client must not terminate the entire server
+    ::signal(SIGPIPE, SIG_IGN);
+
+    ConnectionQueue queue;
+    queue.maxSize = 4*threads_;
+    queue.server = this;
+
+    std::vector<pthread_t> workers(threads_);
+    for (unsigned threadI = 0; threadI < workers.size(); ++threadI)
+    {
+        if (::pthread_create(&workers[threadI], NULL, worker, &queue))
+        {
+            error_ = "could not create worker threads";
+            return 1;
+        }
+    }
+
+    // clients that stall while sending their requests or while reading
+    // the replies are dropped by dispatch() after a timeout, so they
+    // cannot tie up a worker indefinitely
+    while (true)
+    {
+        const int sockfd = this->accept();
+        if (sockfd < 0)
+        {
+            continue;
+        }
+
+        markutil::Mutex::Lock lock(queue.mutex);
+        while (queue.fds.size() >= queue.maxSize)
+        {
+            queue.notFull.wait(queue.mutex);
+        }
+
+        queue.fds.push_back(sockfd);
+        queue.notEmpty.signal();
+    }
+
+    return 0;
+}
+
+
+int markutil::HttpServer::run_prefork()
+{
+    // the sockets of the workers can only share the port if this one
+    // also allows it. Keep it bound but not listening, which reserves
+    // the port without receiving any connections
+    if (!this->reopen(true) || !this->bind(port_))
+    {
+        return 1;
+    }
+
+    // the children must be reaped to be replaced
+    ::signal(SIGCHLD, SIG_DFL);
+
+    std::vector<pid_t> pids(processes_, 0);
+    std::vector<time_t> started(processes_, 0);
+
+    while (true)
+    {
+        for (unsigned procI = 0; procI < pids.size(); ++procI)
+        {
+            if (pids[procI] > 0)
+            {
+                continue;
+            }
+
+            // avoid a fork storm when the workers die immediately
+            if (time(0) - started[procI] < 1)
+            {
+                ::sleep(1);
+            }
+
+            started[procI] = time(0);
+
+            const int pid = this->spawn();
+            if (pid == 0)
+            {
+                // worker: listen on its own socket. On leaving, skip the
+                // cleanup of the state (threads, locks) left by the master
+                if (!this->reopen(true) || !this->bind(port_))
+                {
+                    ::_exit(1);
+                }
+
+                this->process_init();
+
+                ::_exit(this->run_epoll());
+            }
+
+            // a failed fork is retried on the next pass
+            pids[procI] = pid;
+        }
+
+        // the workers live on, the master only does its own work
+        this->process_wait();
+
+        // reap the workers that exited, to be replaced on the next pass
+        int status;
+        pid_t pid;
+        while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            for (unsigned procI = 0; procI < pids.size(); ++procI)
+            {
+                if (pids[procI] == pid)
+                {
+                    pids[procI] = 0;
+                    break;
+                }
             }
         }
     }
@@ -654,6 +1360,12 @@ int markutil::HttpServer::run_select()
 }
 
 
+void markutil::HttpServer::process_wait()
+{
+    ::sleep(1);
+}
+
+
 int markutil::HttpServer::run(RunType how)
 {
     switch (how)
@@ -664,6 +1376,15 @@ int markutil::HttpServer::run(RunType how)
         case SELECT:
             return run_select();
             break;
+        case EPOLL:
+            return run_epoll();
+            break;
+        case THREADPOOL:
+            return run_threadpool();
+            break;
+        case PREFORK:
+            return run_prefork();
+            break;
     }
 
     return 0;
@@ -782,6 +1503,11 @@ int markutil::HttpServer::server_info(std::ostream& os, HttpHeader& head) const
         }
         os  << "</blockquote>\n";
 
+        os  << "<hr /><h3>Document Cache</h3><blockquote>"
+            << "Hits: "   << files_.hits() << br
+            << "Misses: " << files_.misses() << br
+            << "</blockquote>\n";
+
         this->content_info(os, head);
 
         os  << " <hr />";
@@ -794,7 +1520,7 @@ int markutil::HttpServer::server_info(std::ostream& os, HttpHeader& head) const
 
 int markutil::HttpServer::cgi(int fd, HttpHeader& head) const
 {
-    boost::fdostream os(fd);
+    SocketStream os(fd);
     if (notGetOrHead(os, head))
     {
         return 1;
@@ -843,26 +1569,24 @@ int markutil::HttpServer::cgi(int fd, HttpHeader& head) const
                 // parent
 
                 // read and send blockwise - last block may be smaller
-                size_t nread;
+                char buffer[BufSize];
+                ssize_t nread;
                 while ( (nread = ::read(readerFd, buffer, BufSize)) > 0 )
                 {
                     // okay, we did read something
                     ret = 0;
 
-                    size_t noff = 0;
-                    while (nread)
+                    if (!writeAll(fd, buffer, nread))
                     {
-                        size_t nwrite = ::write(fd, &buffer[noff], nread);
-                        nread -= nwrite;
-                        noff  += nwrite;
+                        break;
                     }
                 }
 
-                // this is really just pclose
+                // this is really just pclose, but only for our own child
                 if (::close(readerFd) == 0)
                 {
                     int waitstat;
-                    ::wait(&waitstat);
+                    ::waitpid(pid, &waitstat, 0);
                 }
             }
         }
@@ -874,8 +1598,6 @@ int markutil::HttpServer::cgi(int fd, HttpHeader& head) const
 
     if (ret)
     {
-        boost::fdostream os(fd);
-
         head(head._503_SERVICE_UNAVAILABLE);
         head.print(os);
 
@@ -909,41 +1631,32 @@ int markutil::HttpServer::reply(std::ostream& os, HttpHeader& head) const
     }
 
 
-    // the file name and file-descriptor
+    // the file name
     std::string file = this->root() + req.path();
-    std::string mimeType;
-    int fileFd = -1;
-
 
     // rewrite rules:
     // - convert trailing slash to index.html file
     // - special treatment for "/" request:
     //   * return server-about if there is no index.html
     //
+    HttpFileCache::Ptr entry;
     if (*(file.rbegin()) == '/')
     {
         file += "index.html";
-        fileFd = ::open(file.c_str(), O_RDONLY);
+        entry = files_.lookup(file);
 
-        if (fileFd == -1)
-        {
-            if (req.path() == "/")
-            {
-                return this->server_about(os, head);
-            }
-        }
-        else
+        if (!entry.valid() && req.path() == "/")
         {
-            mimeType = HttpCore::lookupMime("html");
+            return this->server_about(os, head);
         }
     }
     else
     {
-        mimeType = HttpCore::lookupMime(req.ext());
+        entry = files_.lookup(file);
     }
 
-
-    if (mimeType.empty())
+    // unknown type, not a file, or not readable
+    if (!entry.valid())
     {
         head(head._404_NOT_FOUND);
         head.print(os, true);
@@ -951,34 +1664,35 @@ int markutil::HttpServer::reply(std::ostream& os, HttpHeader& head) const
         return 1;
     }
 
+    head.contentType(entry->mime());
 
-    // open the file for reading if not previously opened
-    if (fileFd == -1)
+    // prefer a precompressed sibling, if the client accepts it
+    HttpFileCache::Ptr gzEntry = files_.lookupGzip(file);
+    if (gzEntry.valid())
     {
-        fileFd = ::open(file.c_str(), O_RDONLY);
+        head("Vary", "Accept-Encoding");
+
+        if (req.acceptsGzip())
+        {
+            head("Content-Encoding", "gzip");
+            entry = gzEntry;
+        }
     }
 
-    if (fileFd == -1)
+    if (head.validate(entry->etag(), entry->mtime()))
     {
-        head(head._404_NOT_FOUND);
-        head.print(os, true);
-        return 1;
+        os  << head;
+        return 0;
     }
 
-    head.contentType(mimeType);
+    head.contentLength(entry->size());
+
     os  << head(head._200_OK);
     if (req.type() == req.GET)
     {
-        // send file blockwise - last block may be smaller
-        size_t nbyte;
-        while ( (nbyte = ::read(fileFd, buffer, BufSize)) > 0 )
-        {
-            os.write(buffer, nbyte);
-        }
+        sendFile(os, *entry);
     }
 
-    ::close(fileFd);
-
     return 0;
 }
 
@@ -37,6 +37,7 @@ Notes
 #ifndef MARK_HTTP_SERVER_H
 #define MARK_HTTP_SERVER_H
 
+#include "markutil/HttpFileCache.hpp"
 #include "markutil/HttpHeader.hpp"
 #include "markutil/SocketServer.hpp"
 
@@ -48,6 +49,10 @@ Notes
 namespace markutil
 {
 
+// Forward declaration of classes
+class HttpConnection;
+
+
 /*---------------------------------------------------------------------------*\
                          Class HttpServer Declaration
 \*---------------------------------------------------------------------------*/
@@ -74,15 +79,44 @@ class HttpServer
         //- The cgi-bin
         std::string cgibin_;
 
+        //- The number of worker threads for the thread-pool server
+        unsigned threads_;
+
+        //- The number of worker processes for the pre-forking server
+        unsigned processes_;
+
+        //- The open files of the static documents served
+        mutable HttpFileCache files_;
+
 
     // Private Member Functions
 
         //! set absolute or relative path
         bool setPath(std::string& target, const std::string& path);
 
-        //! dispatch to cgi or normal document serving
+        //! serve all requests on a (blocking) persistent connection
         int dispatch(int sockfd);
 
+        //! dispatch to cgi or normal document serving,
+        //  the request is already embedded in the reply header.
+        //  The response to a normal document is completed with its
+        //  Content-Length before it is sent, and whatever the socket
+        //  does not take is kept as the output of the connection.
+        //  \return true if the connection may be kept open
+        bool dispatch(HttpConnection&, HttpHeader& head);
+
+        //! reply to every complete request received on the connection,
+        //  in order, but only once the previous reply has been sent
+        //  \return false if the connection is finished
+        bool serve(HttpConnection&);
+
+        //! Entry point for the thread-pool worker threads
+        static void* worker(void*);
+
+        //! Start a pre-forked worker process
+        //  \return pid in the master, 0 in the worker, -1 on failure
+        int spawn();
+
 protected:
 
     // Protected Member Functions
@@ -108,7 +142,10 @@ public:
     enum RunType
     {
         FORKING,    //!< traditional forking server
-        SELECT      //!< select-based server
+        SELECT,     //!< select-based server
+        EPOLL,      //!< epoll-based server (edge-triggered)
+        THREADPOOL, //!< acceptor with a pool of worker threads
+        PREFORK     //!< pre-forked epoll-based worker processes
     };
 
 
@@ -137,6 +174,12 @@ public:
         //- The default prefix for cgi-bin, no trailing slash
         static std::string defaultCgiPrefix;
 
+        //- The default number of worker threads for the thread-pool server
+        static unsigned defaultThreads;
+
+        //- The default number of worker processes for the pre-forking server
+        static unsigned defaultProcesses;
+
 
     // Static Functions
 
@@ -177,6 +220,12 @@ public:
             //- The CGI prefix
             const std::string& cgiPrefix() const;
 
+            //- The number of worker threads for the thread-pool server
+            unsigned threads() const;
+
+            //- The number of worker processes for the pre-forking server
+            unsigned processes() const;
+
 
         // Edit
 
@@ -196,6 +245,12 @@ public:
             //- Set the CGI prefix
             bool cgiPrefix(const std::string& prefix);
 
+            //- Set the number of worker threads for the thread-pool server
+            bool threads(unsigned n);
+
+            //- Set the number of worker processes for the pre-forking server
+            bool processes(unsigned n);
+
 
         // General Operation
 
@@ -204,9 +259,28 @@ public:
             int run_fork();
 
             //- Enter infinite loop, replying to incoming requests
-            //  Use a select-based server
+            //  Use a select-based server, which never blocks on slow
+            //  clients
             int run_select();
 
+            //- Enter infinite loop, replying to incoming requests
+            //  Use an epoll-based server, which has no limit on the
+            //  number of connections and never blocks on slow clients
+            //  while reading their requests or the replies
+            int run_epoll();
+
+            //- Enter infinite loop, replying to incoming requests
+            //  Use a pool of worker threads, fed by the accepting thread.
+            //  The reply() and related methods must be thread-safe.
+            int run_threadpool();
+
+            //- Enter infinite loop, replying to incoming requests
+            //  Use a fixed number of long-lived worker processes, each
+            //  with its own listening socket on the port (SO_REUSEPORT)
+            //  and running the epoll-based server. The master process
+            //  only replaces workers that die.
+            int run_prefork();
+
             //- Enter infinite loop, replying to incoming requests
             //  Use the specified server type
             int run(RunType how = FORKING);
@@ -218,6 +292,17 @@ public:
             //- Reply to the incoming request, which is already embedded in the reply header
             virtual int reply(std::ostream&, HeaderType&) const;
 
+            //- Called in each pre-forked worker process before it
+            //  starts serving, eg to start per-process threads,
+            //  which do not survive the fork
+            virtual void process_init()
+            {}
+
+            //- Called repeatedly in the master of the pre-forking server,
+            //  blocking for up to about a second, eg to update data that
+            //  the workers read. The default only waits.
+            virtual void process_wait();
+
             //- Reply with basic server information as html
             virtual int server_about(std::ostream&, HttpHeader&) const;
 
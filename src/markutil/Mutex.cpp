@@ -0,0 +1,104 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/Mutex.hpp"
+
+#include <ctime>
+#include <cerrno>
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::Mutex::Mutex()
+{
+    ::pthread_mutex_init(&mutex_, NULL);
+}
+
+
+markutil::Condition::Condition()
+{
+    ::pthread_cond_init(&cond_, NULL);
+}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+markutil::Mutex::~Mutex()
+{
+    ::pthread_mutex_destroy(&mutex_);
+}
+
+
+markutil::Condition::~Condition()
+{
+    ::pthread_cond_destroy(&cond_);
+}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+void markutil::Mutex::lock()
+{
+    ::pthread_mutex_lock(&mutex_);
+}
+
+
+bool markutil::Mutex::trylock()
+{
+    return ::pthread_mutex_trylock(&mutex_) == 0;
+}
+
+
+void markutil::Mutex::unlock()
+{
+    ::pthread_mutex_unlock(&mutex_);
+}
+
+
+void markutil::Condition::wait(Mutex& m)
+{
+    ::pthread_cond_wait(&cond_, &m.mutex_);
+}
+
+
+bool markutil::Condition::wait(Mutex& m, unsigned seconds)
+{
+    struct timespec abstime;
+    abstime.tv_sec  = ::time(NULL) + seconds;
+    abstime.tv_nsec = 0;
+
+    return ::pthread_cond_timedwait(&cond_, &m.mutex_, &abstime) != ETIMEDOUT;
+}
+
+
+void markutil::Condition::signal()
+{
+    ::pthread_cond_signal(&cond_);
+}
+
+
+void markutil::Condition::broadcast()
+{
+    ::pthread_cond_broadcast(&cond_);
+}
+
+
+// ************************************************************************* //
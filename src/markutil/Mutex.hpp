@@ -0,0 +1,187 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    markutil::Mutex
+
+Description
+    A thin wrapper around a (non-recursive) pthread mutex,
+    with a scoped markutil::Mutex::Lock and a markutil::Condition
+    variable to go with it.
+
+SourceFiles
+    Mutex.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_MUTEX_H
+#define MARK_MUTEX_H
+
+#include <pthread.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+// Forward declaration of classes
+class Condition;
+
+
+/*---------------------------------------------------------------------------*\
+                           Class Mutex Declaration
+\*---------------------------------------------------------------------------*/
+
+class Mutex
+{
+    // Private data
+
+        //- The underlying mutex
+        pthread_mutex_t mutex_;
+
+
+    // Private Member Functions
+
+        //- Disallow default bitwise copy construct
+        Mutex(const Mutex&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const Mutex&);
+
+
+public:
+
+    friend class Condition;
+
+
+    //- Scoped locking of a mutex
+    class Lock
+    {
+        Mutex& mutex_;
+
+        //- Disallow default bitwise copy construct
+        Lock(const Lock&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const Lock&);
+
+    public:
+
+        //- Lock the mutex for the lifetime of this object
+        explicit Lock(Mutex& m)
+        :
+            mutex_(m)
+        {
+            mutex_.lock();
+        }
+
+        //- Unlock the mutex
+        ~Lock()
+        {
+            mutex_.unlock();
+        }
+    };
+
+
+    // Constructors
+
+        //- Construct unlocked
+        Mutex();
+
+
+    //- Destructor
+    ~Mutex();
+
+
+    // Member Functions
+
+        //- Lock the mutex, blocking as required
+        void lock();
+
+        //- Try to lock the mutex without blocking
+        //  \return true if the lock was obtained
+        bool trylock();
+
+        //- Unlock the mutex
+        void unlock();
+
+};
+
+
+/*---------------------------------------------------------------------------*\
+                          Class Condition Declaration
+\*---------------------------------------------------------------------------*/
+
+class Condition
+{
+    // Private data
+
+        //- The underlying condition variable
+        pthread_cond_t cond_;
+
+
+    // Private Member Functions
+
+        //- Disallow default bitwise copy construct
+        Condition(const Condition&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const Condition&);
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        Condition();
+
+
+    //- Destructor
+    ~Condition();
+
+
+    // Member Functions
+
+        //- Wait on the condition. The mutex must be locked by the caller.
+        void wait(Mutex&);
+
+        //- Wait on the condition for at most the given number of seconds.
+        //  The mutex must be locked by the caller.
+        //  \return false if the wait timed out
+        bool wait(Mutex&, unsigned seconds);
+
+        //- Wake a single waiting thread
+        void signal();
+
+        //- Wake all waiting threads
+        void broadcast();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_MUTEX_H
+
+// ************************************************************************* //
@@ -0,0 +1,215 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    markutil::RefPtr
+
+Description
+    An intrusive reference-counting pointer for classes derived from
+    markutil::RefCount. The count is updated atomically, so a RefPtr can
+    be copied and released from different threads, but a single RefPtr
+    object itself must not be modified concurrently.
+
+    The object is deleted when the last RefPtr referencing it goes away.
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_REFPTR_H
+#define MARK_REFPTR_H
+
+#include <cstddef>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+/*---------------------------------------------------------------------------*\
+                          Class RefCount Declaration
+\*---------------------------------------------------------------------------*/
+
+//! Base class for objects managed by a RefPtr
+class RefCount
+{
+    // Private data
+
+        //- The reference count
+        mutable int count_;
+
+
+    // Private Member Functions
+
+        //- Disallow default bitwise copy construct
+        RefCount(const RefCount&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const RefCount&);
+
+
+public:
+
+    // Constructors
+
+        //- Construct with a zero count
+        RefCount()
+        :
+            count_(0)
+        {}
+
+
+    //- Destructor
+    virtual ~RefCount()
+    {}
+
+
+    // Member Functions
+
+        //- The current reference count
+        int count() const
+        {
+            return count_;
+        }
+
+        //- Increment the reference count
+        void ref() const
+        {
+            __sync_add_and_fetch(&count_, 1);
+        }
+
+        //- Decrement the reference count, return true when it drops to zero
+        bool unref() const
+        {
+            return __sync_sub_and_fetch(&count_, 1) == 0;
+        }
+
+};
+
+
+/*---------------------------------------------------------------------------*\
+                           Class RefPtr Declaration
+\*---------------------------------------------------------------------------*/
+
+template<class T>
+class RefPtr
+{
+    // Private data
+
+        //- The managed object
+        T* ptr_;
+
+
+public:
+
+    // Constructors
+
+        //- Construct null
+        RefPtr()
+        :
+            ptr_(NULL)
+        {}
+
+        //- Take ownership of a pointer
+        explicit RefPtr(T* p)
+        :
+            ptr_(p)
+        {
+            if (ptr_)
+            {
+                ptr_->ref();
+            }
+        }
+
+        //- Copy construct, sharing the object
+        RefPtr(const RefPtr<T>& rp)
+        :
+            ptr_(rp.ptr_)
+        {
+            if (ptr_)
+            {
+                ptr_->ref();
+            }
+        }
+
+
+    //- Destructor
+    ~RefPtr()
+    {
+        reset();
+    }
+
+
+    // Member Functions
+
+        //- True if a pointer is held
+        bool valid() const
+        {
+            return ptr_;
+        }
+
+        //- The raw pointer
+        T* get() const
+        {
+            return ptr_;
+        }
+
+        //- Release the object, deleting it if this was the last reference
+        void reset()
+        {
+            if (ptr_ && ptr_->unref())
+            {
+                delete ptr_;
+            }
+            ptr_ = NULL;
+        }
+
+
+    // Member Operators
+
+        T& operator*() const
+        {
+            return *ptr_;
+        }
+
+        T* operator->() const
+        {
+            return ptr_;
+        }
+
+        void operator=(const RefPtr<T>& rp)
+        {
+            if (rp.ptr_)
+            {
+                rp.ptr_->ref();
+            }
+            reset();
+            ptr_ = rp.ptr_;
+        }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_REFPTR_H
+
+// ************************************************************************* //
@@ -99,15 +99,23 @@ bool markutil::SocketInfo::getAddrAndPort
     {
         sock_addr = buf;
 
-        struct hostent *hp = ::gethostbyaddr
+        // reentrant reverse lookup
+        char host[NI_MAXHOST];
+        if
         (
-            &(sockAddr.sin_addr.s_addr),
-            sizeof(sockAddr.sin_addr.s_addr),
-            AF_INET
-        );
-        if (hp)
+            ::getnameinfo
+            (
+                reinterpret_cast<struct sockaddr *>(&sockAddr),
+                sin_len,
+                host,
+                sizeof(host),
+                NULL,
+                0,
+                NI_NAMEREQD
+            ) == 0
+        )
         {
-            sock_host = hp->h_name;
+            sock_host = host;
         }
         else
         {
@@ -0,0 +1,200 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/SocketOutput.hpp"
+#include "markutil/SocketServer.hpp"
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void markutil::SocketOutput::keep
+(
+    const struct iovec* iov,
+    int iovcnt,
+    const RefCount* owner
+)
+{
+    if (owner && iovcnt && iov[iovcnt-1].iov_len)
+    {
+        --iovcnt;
+        data_ = static_cast<const char*>(iov[iovcnt].iov_base);
+        len_ = iov[iovcnt].iov_len;
+        owner_ = RefPtr<const RefCount>(owner);
+    }
+
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        text_.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    }
+}
+
+
+void markutil::SocketOutput::release()
+{
+    data_ = NULL;
+    fileFd_ = -1;
+    offset_ = 0;
+    len_ = 0;
+    owner_.reset();
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::SocketOutput::SocketOutput(int fd)
+:
+    fd_(fd),
+    text_(),
+    written_(0),
+    data_(NULL),
+    fileFd_(-1),
+    offset_(0),
+    len_(0),
+    owner_()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+bool markutil::SocketOutput::writev
+(
+    struct iovec* iov,
+    int iovcnt,
+    const RefCount* owner
+)
+{
+    if (len_)
+    {
+        return false;   // nothing may follow shared data or a file
+    }
+
+    if (written_ == text_.size())
+    {
+        text_.clear();
+        written_ = 0;
+
+        if (!SocketServer::writevSome(fd_, iov, iovcnt))
+        {
+            return false;
+        }
+    }
+
+    keep(iov, iovcnt, owner);
+
+    return true;
+}
+
+
+bool markutil::SocketOutput::sendfile
+(
+    int fd,
+    off_t offset,
+    size_t len,
+    const RefCount* owner
+)
+{
+    if (len_)
+    {
+        return false;   // nothing may follow shared data or a file
+    }
+
+    if
+    (
+        written_ == text_.size()
+     && !SocketServer::sendfileSome(fd_, fd, offset, len)
+    )
+    {
+        return false;
+    }
+
+    if (len)
+    {
+        fileFd_ = fd;
+        offset_ = offset;
+        len_ = len;
+        owner_ = RefPtr<const RefCount>(owner);
+    }
+
+    return true;
+}
+
+
+bool markutil::SocketOutput::flush()
+{
+    if (written_ < text_.size() || data_)
+    {
+        struct iovec iov[2];
+        iov[0].iov_base = const_cast<char*>(text_.data()) + written_;
+        iov[0].iov_len = text_.size() - written_;
+        iov[1].iov_base = const_cast<char*>(data_);
+        iov[1].iov_len = (data_ ? len_ : 0);
+
+        struct iovec* remain = iov;
+        int nRemain = 2;
+
+        if (!SocketServer::writevSome(fd_, remain, nRemain))
+        {
+            return false;
+        }
+
+        written_ = text_.size() - iov[0].iov_len;
+        if (data_)
+        {
+            data_ = static_cast<const char*>(iov[1].iov_base);
+            len_ = iov[1].iov_len;
+        }
+    }
+
+    if (written_ < text_.size())
+    {
+        return true;
+    }
+
+    text_.clear();
+    written_ = 0;
+
+    if
+    (
+        fileFd_ >= 0
+     && !SocketServer::sendfileSome(fd_, fileFd_, offset_, len_)
+    )
+    {
+        return false;
+    }
+
+    if (!len_)
+    {
+        release();
+    }
+
+    return true;
+}
+
+
+void markutil::SocketOutput::clear()
+{
+    text_.clear();
+    written_ = 0;
+    release();
+}
+
+
+// ************************************************************************* //
@@ -0,0 +1,158 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Class
+    markutil::SocketOutput
+
+Description
+    The output to a non-blocking socket that it did not take yet, for an
+    event-driven server that must not wait for a slow reader.
+
+    Output is written without waiting, and whatever the socket does not
+    take is kept: text is copied, whereas shared data (eg, a cached
+    response body) or part of a file is kept by reference together with
+    its owner. The rest is written by flush() once the socket becomes
+    writable again. Shared data or a file can only end the output.
+
+SourceFiles
+    SocketOutput.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_SOCKETOUTPUT_H
+#define MARK_SOCKETOUTPUT_H
+
+#include "markutil/RefPtr.hpp"
+
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+/*---------------------------------------------------------------------------*\
+                        Class SocketOutput Declaration
+\*---------------------------------------------------------------------------*/
+
+class SocketOutput
+{
+    // Private data
+
+        //- The socket file descriptor
+        int fd_;
+
+        //- The text not yet written
+        std::string text_;
+
+        //- The size of the text already written
+        size_t written_;
+
+        //- The shared data to write after the text, NULL for none
+        const char* data_;
+
+        //- The file to send after the text, -1 for none
+        int fileFd_;
+
+        //- The start of the rest of the file
+        off_t offset_;
+
+        //- The number of bytes of the data or file not yet written
+        size_t len_;
+
+        //- The owner of the data or file descriptor,
+        //  kept until it has been written
+        RefPtr<const RefCount> owner_;
+
+
+    // Private Member Functions
+
+        //- Keep what remains of the iovec array. With an owner, the last
+        //  buffer is shared data kept by reference instead of copied
+        void keep(const struct iovec* iov, int iovcnt, const RefCount* owner);
+
+        //- Release the shared data or file once written
+        void release();
+
+
+public:
+
+    // Constructors
+
+        //- Construct empty for the given (non-blocking) socket
+        explicit SocketOutput(int fd = -1);
+
+
+    // Member Functions
+
+        // Access
+
+            //- Has all output been written?
+            bool empty() const
+            {
+                return written_ == text_.size() && !len_;
+            }
+
+
+        // Edit
+
+            //- Write the data described by the iovec array without
+            //  waiting, after anything kept, and keep the rest.
+            //  With an owner, the last buffer is shared data.
+            //  \return false on error
+            bool writev
+            (
+                struct iovec* iov,
+                int iovcnt,
+                const RefCount* owner = NULL
+            );
+
+            //- Send part of a file without waiting, after anything kept,
+            //  and keep the rest with the owner of the file descriptor
+            //  \return false on error
+            bool sendfile
+            (
+                int fd,
+                off_t offset,
+                size_t len,
+                const RefCount* owner = NULL
+            );
+
+            //- Write as much of what is kept as the socket takes
+            //  \return false on error
+            bool flush();
+
+            //- Discard what is kept
+            void clear();
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_SOCKETOUTPUT_H
+
+// ************************************************************************* //
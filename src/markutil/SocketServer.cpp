@@ -25,7 +25,36 @@ License
 #include <iostream>
 #include <string>
 #include <netdb.h>
+#include <cerrno>
 #include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+
+
+// * * * * * * * * * * * * * * * Local Functions * * * * * * * * * * * * * * //
+
+//! \cond local scope
+
+// wait for a non-blocking socket to become writable
+static bool waitWritable(int sockfd, int timeout)
+{
+    struct pollfd pfd;
+    pfd.fd = sockfd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+
+    int ready;
+    do
+    {
+        ready = ::poll(&pfd, 1, 1000*timeout);
+    }
+    while (ready < 0 && errno == EINTR);
+
+    return ready > 0;
+}
+
+//! \endcond
 
 
 // * * * * * * * * * * * * Static Member Functions * * * * * * * * * * * * * //
@@ -76,9 +105,168 @@ bool markutil::SocketServer::setNonBlocking(int sockfd)
 }
 
 
+bool markutil::SocketServer::writeAll
+(
+    int sockfd,
+    const char* buf,
+    size_t len,
+    int timeout
+)
+{
+    struct iovec iov;
+    iov.iov_base = const_cast<char*>(buf);
+    iov.iov_len = len;
+
+    return writevAll(sockfd, &iov, 1, timeout);
+}
+
+
+bool markutil::SocketServer::writevSome
+(
+    int sockfd,
+    struct iovec*& iov,
+    int& iovcnt
+)
+{
+    while (true)
+    {
+        // skip what has been written
+        while (iovcnt && !iov->iov_len)
+        {
+            ++iov;
+            --iovcnt;
+        }
+
+        if (!iovcnt)
+        {
+            return true;
+        }
+
+        const ssize_t n = ::writev(sockfd, iov, iovcnt);
+
+        if (n >= 0)
+        {
+            size_t nwritten = n;
+            while (nwritten)
+            {
+                const size_t len =
+                (
+                    nwritten < iov->iov_len ? nwritten : iov->iov_len
+                );
+
+                iov->iov_base = static_cast<char*>(iov->iov_base) + len;
+                iov->iov_len -= len;
+                nwritten -= len;
+
+                if (!iov->iov_len)
+                {
+                    ++iov;
+                    --iovcnt;
+                }
+            }
+        }
+        else if (errno != EINTR)
+        {
+            // non-blocking socket without room is not an error
+            return (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+}
+
+
+bool markutil::SocketServer::writevAll
+(
+    int sockfd,
+    struct iovec* iov,
+    int iovcnt,
+    int timeout
+)
+{
+    while (true)
+    {
+        if (!writevSome(sockfd, iov, iovcnt))
+        {
+            return false;
+        }
+
+        if (!iovcnt)
+        {
+            return true;
+        }
+
+        // non-blocking socket: wait until there is room again
+        if (!waitWritable(sockfd, timeout))
+        {
+            return false;
+        }
+    }
+}
+
+
+bool markutil::SocketServer::sendfileSome
+(
+    int sockfd,
+    int fileFd,
+    off_t& offset,
+    size_t& len
+)
+{
+    while (len)
+    {
+        const ssize_t n = ::sendfile(sockfd, fileFd, &offset, len);
+
+        if (n > 0)
+        {
+            len -= n;
+        }
+        else if (n == 0)
+        {
+            return false;   // the file is shorter than expected
+        }
+        else if (errno != EINTR)
+        {
+            // non-blocking socket without room is not an error
+            return (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+
+    return true;
+}
+
+
+bool markutil::SocketServer::sendfileAll
+(
+    int sockfd,
+    int fileFd,
+    off_t offset,
+    size_t len,
+    int timeout
+)
+{
+    while (true)
+    {
+        if (!sendfileSome(sockfd, fileFd, offset, len))
+        {
+            return false;
+        }
+
+        if (!len)
+        {
+            return true;
+        }
+
+        // non-blocking socket: wait until there is room again
+        if (!waitWritable(sockfd, timeout))
+        {
+            return false;
+        }
+    }
+}
+
+
 // * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
 
-bool markutil::SocketServer::create(bool reuse)
+bool markutil::SocketServer::create(bool reuse, bool reusePort)
 {
     state_ = UNKNOWN;
 
@@ -110,6 +298,31 @@ bool markutil::SocketServer::create(bool reuse)
         }
     }
 
+    // share the port with other sockets
+    if (reusePort)
+    {
+#ifdef SO_REUSEPORT
+        int sockopt = 1;
+        int retval = ::setsockopt
+        (
+            fd_,
+            SOL_SOCKET,
+            SO_REUSEPORT,
+            &sockopt,
+            sizeof(sockopt)
+        );
+#else
+        int retval = -1;
+#endif
+
+        if (retval == -1)
+        {
+            error_ = "SocketServer: SO_REUSEPORT not supported";
+            this->close();
+            return false;
+        }
+    }
+
     // Change to non-blocking socket
 //    char arg;
 //    if (::ioctl(fd_, FIONBIO, &arg) == -1)
@@ -300,6 +513,13 @@ void markutil::SocketServer::close()
 }
 
 
+bool markutil::SocketServer::reopen(bool reusePort)
+{
+    this->close();
+    return this->create(true, reusePort);
+}
+
+
 bool markutil::SocketServer::bound() const
 {
     return state_ >= BOUND;
@@ -31,7 +31,10 @@ SourceFiles
 #ifndef MARK_SOCKETSERVER_H
 #define MARK_SOCKETSERVER_H
 
+#include <cstddef>
 #include <string>
+#include <sys/types.h>
+#include <sys/uio.h>
 
 // * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
 
@@ -48,8 +51,9 @@ class SocketServer
 
     // Private Member Functions
 
-        //! Create a socket
-        bool create(bool reuse);
+        //! Create a socket, optionally allowing several sockets
+        //  to be bound to the same port (SO_REUSEPORT)
+        bool create(bool reuse, bool reusePort = false);
 
 
 protected:
@@ -110,6 +114,83 @@ public:
         //  \return true on success
         static bool setNonBlocking(int sockfd);
 
+        //! \brief Write all of the data to a (blocking or non-blocking)
+        //  socket, retrying after interrupts and partial writes
+        //  \param sockfd The socket file descriptor
+        //  \param timeout The time (seconds) to wait for the socket to
+        //  become writable
+        //  \return true on success
+        static bool writeAll
+        (
+            int sockfd,
+            const char* buf,
+            size_t len,
+            int timeout = 30
+        );
+
+        //! \brief Write as much of the data described by the iovec array
+        //  (as per writev) as a non-blocking socket takes without
+        //  waiting, retrying after interrupts and partial writes.
+        //  The iovec array is advanced to describe what remains.
+        //  \param sockfd The socket file descriptor
+        //  \return true unless there was an error
+        static bool writevSome
+        (
+            int sockfd,
+            struct iovec*& iov,
+            int& iovcnt
+        );
+
+        //! \brief Write all of the data described by the iovec array
+        //  (as per writev) to a (blocking or non-blocking) socket,
+        //  retrying after interrupts and partial writes.
+        //  The iovec array is modified in the process.
+        //  \param sockfd The socket file descriptor
+        //  \param timeout The time (seconds) to wait for the socket to
+        //  become writable
+        //  \return true on success
+        static bool writevAll
+        (
+            int sockfd,
+            struct iovec* iov,
+            int iovcnt,
+            int timeout = 30
+        );
+
+        //! \brief Send as much of part of a file with sendfile() as a
+        //  non-blocking socket takes without waiting, retrying after
+        //  interrupts and partial transfers.
+        //  The offset and length are advanced to describe what remains.
+        //  \param sockfd The socket file descriptor
+        //  \param fileFd The file descriptor, its offset is unchanged
+        //  \return true unless there was an error
+        static bool sendfileSome
+        (
+            int sockfd,
+            int fileFd,
+            off_t& offset,
+            size_t& len
+        );
+
+        //! \brief Send part of a file to a (blocking or non-blocking)
+        //  socket with sendfile(), retrying after interrupts and
+        //  partial transfers
+        //  \param sockfd The socket file descriptor
+        //  \param fileFd The file descriptor, its offset is unchanged
+        //  \param offset The start of the data within the file
+        //  \param len The number of bytes to send
+        //  \param timeout The time (seconds) to wait for the socket to
+        //  become writable
+        //  \return true on success
+        static bool sendfileAll
+        (
+            int sockfd,
+            int fileFd,
+            off_t offset,
+            size_t len,
+            int timeout = 30
+        );
+
         //! \brief Set the port for receiving data
         //  Only if not already bound
         //  \param port The port number
@@ -134,6 +215,14 @@ public:
         //! \brief Close the listening socket
         void close();
 
+        //! \brief Close the socket and create a new, unbound one
+        //  With reusePort, several sockets (typically in different
+        //  processes) may bind and listen on the same port and the
+        //  kernel distributes the incoming connections between them.
+        //  All of these sockets must be created with reusePort.
+        //  \return true on success
+        bool reopen(bool reusePort = false);
+
         //! \brief Is file-descriptor bound to a port?
         bool bound() const;
 
@@ -0,0 +1,318 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+\*---------------------------------------------------------------------------*/
+
+#include "markutil/SocketStream.hpp"
+#include "markutil/SocketServer.hpp"
+
+#include <cstring>
+
+
+// * * * * * * * * * * * * * * Static Data Members * * * * * * * * * * * * * //
+
+size_t markutil::SocketStream::defaultBufferSize = 65536;
+
+
+// * * * * * * * * * * * * * Private Member Functions  * * * * * * * * * * * //
+
+void markutil::SocketStreamBuf::grow(size_t len)
+{
+    const size_t used = nPending();
+
+    size_t size = buffer_.size();
+    while (size < used + len)
+    {
+        size *= 2;
+    }
+
+    buffer_.resize(size);
+
+    char* beg = &buffer_[0];
+    setp(beg, beg + buffer_.size());
+    advance(used);
+}
+
+
+void markutil::SocketStreamBuf::advance(size_t len)
+{
+    // pbump only takes an int
+    while (len)
+    {
+        const int step = (len > 0x40000000 ? 0x40000000 : len);
+        pbump(step);
+        len -= step;
+    }
+}
+
+
+bool markutil::SocketStreamBuf::write
+(
+    struct iovec* iov,
+    int iovcnt,
+    const RefCount* owner
+)
+{
+    return
+    (
+        backlog_
+      ? backlog_->writev(iov, iovcnt, owner)
+      : SocketServer::writevAll(fd_, iov, iovcnt)
+    );
+}
+
+
+bool markutil::SocketStreamBuf::writeFile
+(
+    int fd,
+    off_t offset,
+    size_t len,
+    const RefCount* owner
+)
+{
+    return
+    (
+        backlog_
+      ? backlog_->sendfile(fd, offset, len, owner)
+      : SocketServer::sendfileAll(fd_, fd, offset, len)
+    );
+}
+
+
+bool markutil::SocketStreamBuf::send(const char* data, size_t len)
+{
+    if (!failed_)
+    {
+        struct iovec iov[2];
+        iov[0].iov_base = pbase();
+        iov[0].iov_len = nPending();
+        iov[1].iov_base = const_cast<char*>(data);
+        iov[1].iov_len = len;
+
+        failed_ = !write(iov, 2, NULL);
+    }
+
+    discard();
+
+    return !failed_;
+}
+
+
+// * * * * * * * * * * * * * Protected Member Functions  * * * * * * * * * * //
+
+markutil::SocketStreamBuf::int_type
+markutil::SocketStreamBuf::overflow(int_type c)
+{
+    if (hold_)
+    {
+        grow(1);
+    }
+    else if (!send())
+    {
+        return traits_type::eof();
+    }
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+
+std::streamsize markutil::SocketStreamBuf::xsputn
+(
+    const char* s,
+    std::streamsize num
+)
+{
+    const size_t len = num;
+    const size_t room = epptr() - pptr();
+
+    if (len <= room || hold_)
+    {
+        if (len > room)
+        {
+            grow(len);
+        }
+
+        memcpy(pptr(), s, len);
+        advance(len);
+
+        return num;
+    }
+
+    // too large for the buffer: write it together with the buffer
+    return send(s, len) ? num : 0;
+}
+
+
+int markutil::SocketStreamBuf::sync()
+{
+    if (hold_ || (!nPending() && !tailLen_))
+    {
+        return 0;
+    }
+
+    return sendHeld(nPending(), 0, std::string()) ? 0 : -1;
+}
+
+
+// * * * * * * * * * * * * * * * * Constructors  * * * * * * * * * * * * * * //
+
+markutil::SocketStreamBuf::SocketStreamBuf(int fd, size_t bufferSize)
+:
+    std::streambuf(),
+    fd_(fd),
+    buffer_(bufferSize ? bufferSize : 1),
+    hold_(false),
+    failed_(false),
+    tailFd_(-1),
+    tailData_(NULL),
+    tailOffset_(0),
+    tailLen_(0),
+    tailOwner_(),
+    backlog_(NULL)
+{
+    discard();
+}
+
+
+markutil::SocketStream::SocketStream(int fd, size_t bufferSize)
+:
+    std::ostream(0),
+    buf_(fd, bufferSize)
+{
+    rdbuf(&buf_);
+}
+
+
+// * * * * * * * * * * * * * * * * Destructor  * * * * * * * * * * * * * * * //
+
+markutil::SocketStreamBuf::~SocketStreamBuf()
+{
+    hold_ = false;
+    sync();
+}
+
+
+markutil::SocketStream::~SocketStream()
+{}
+
+
+// * * * * * * * * * * * * * * Member Functions  * * * * * * * * * * * * * * //
+
+bool markutil::SocketStreamBuf::sendfile
+(
+    int fd,
+    off_t offset,
+    size_t len,
+    const RefCount* owner
+)
+{
+    if (hold_)
+    {
+        tailFd_ = fd;
+        tailOffset_ = offset;
+        tailLen_ = len;
+        tailOwner_ = RefPtr<const RefCount>(owner);
+
+        return true;
+    }
+
+    if (send() && !writeFile(fd, offset, len, owner))
+    {
+        failed_ = true;
+    }
+
+    return !failed_;
+}
+
+
+bool markutil::SocketStreamBuf::sendBuffer
+(
+    const char* data,
+    size_t len,
+    const RefCount* owner
+)
+{
+    if (hold_)
+    {
+        tailData_ = data;
+        tailLen_ = len;
+        tailOwner_ = RefPtr<const RefCount>(owner);
+
+        return true;
+    }
+
+    return send(data, len);
+}
+
+
+bool markutil::SocketStreamBuf::sendHeld
+(
+    size_t len,
+    size_t insertAt,
+    const std::string& text
+)
+{
+    if (!failed_)
+    {
+        struct iovec iov[4];
+        iov[0].iov_base = pbase();
+        iov[0].iov_len = insertAt;
+        iov[1].iov_base = const_cast<char*>(text.data());
+        iov[1].iov_len = text.size();
+        iov[2].iov_base = pbase() + insertAt;
+        iov[2].iov_len = len - insertAt;
+        iov[3].iov_base = const_cast<char*>(tailData_);
+        iov[3].iov_len = (tailData_ ? tailLen_ : 0);
+
+        // shared data is only kept by reference with its owner
+        const RefCount* owner = tailOwner_.get();
+
+        failed_ =
+        (
+            !write(iov, 4, tailData_ ? owner : NULL)
+         || (tailFd_ >= 0 && !writeFile(tailFd_, tailOffset_, tailLen_, owner))
+        );
+    }
+
+    discard();
+
+    return !failed_;
+}
+
+
+void markutil::SocketStreamBuf::discard()
+{
+    char* beg = &buffer_[0];
+    setp(beg, beg + buffer_.size());
+
+    tailFd_ = -1;
+    tailData_ = NULL;
+    tailOffset_ = 0;
+    tailLen_ = 0;
+    tailOwner_.reset();
+}
+
+
+// ************************************************************************* //
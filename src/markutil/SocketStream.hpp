@@ -0,0 +1,351 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+
+Class
+    markutil::SocketStream
+
+Description
+    An output stream to a socket with a large buffer, as a replacement
+    for the unbuffered boost::fdostream.
+
+    Output is collected in the buffer and written with as few system
+    calls as possible: large pieces of output that do not fit into the
+    buffer are written together with the buffered output by a single
+    writev(), without being copied into the buffer first. Partial
+    writes, interrupts and a non-blocking socket are handled.
+
+    While held, nothing is written and the buffer grows as required,
+    so that the complete output can be inspected (eg, to determine the
+    Content-Length of a response) before it is sent.
+
+    The content of a file can be sent with sendfile(), and shared data
+    (eg, a cached response body) with sendBuffer(), neither passing
+    through the buffer. While held, either is sent after the held output
+    (as its tail), so it must be the last output.
+
+    With a backlog, output that a non-blocking socket does not take is
+    kept there for the caller to write later, instead of waiting for the
+    socket to become writable.
+
+SourceFiles
+    SocketStream.cpp
+
+\*---------------------------------------------------------------------------*/
+
+#ifndef MARK_SOCKETSTREAM_H
+#define MARK_SOCKETSTREAM_H
+
+#include "markutil/RefPtr.hpp"
+#include "markutil/SocketOutput.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace markutil
+{
+
+/*---------------------------------------------------------------------------*\
+                       Class SocketStreamBuf Declaration
+\*---------------------------------------------------------------------------*/
+
+class SocketStreamBuf
+:
+    public std::streambuf
+{
+    // Private data
+
+        //- The socket file descriptor
+        int fd_;
+
+        //- The output buffer
+        std::vector<char> buffer_;
+
+        //- Hold the output rather than writing it
+        bool hold_;
+
+        //- A write has failed, all further output is discarded
+        bool failed_;
+
+        //- The file to be sent after the held output, -1 for none
+        int tailFd_;
+
+        //- The data to be sent after the held output, NULL for none
+        const char* tailData_;
+
+        //- The start of the data within the file
+        off_t tailOffset_;
+
+        //- The number of bytes of the file or data to send
+        size_t tailLen_;
+
+        //- The owner of the file descriptor or data,
+        //  kept until it has been sent
+        RefPtr<const RefCount> tailOwner_;
+
+        //- Keeps what the socket does not take, NULL to wait instead
+        SocketOutput* backlog_;
+
+
+    // Private Member Functions
+
+        //- Write the data described by the iovec array, the last buffer
+        //  being shared data of the owner (if any)
+        bool write(struct iovec* iov, int iovcnt, const RefCount* owner);
+
+        //- Send part of a file
+        bool writeFile(int fd, off_t offset, size_t len, const RefCount* owner);
+
+        //- Grow the buffer (while held) to accommodate more output
+        void grow(size_t len);
+
+        //- Advance the put pointer
+        void advance(size_t len);
+
+        //- Write the buffered output, followed by the given data
+        bool send(const char* data = NULL, size_t len = 0);
+
+        //- Disallow default bitwise copy construct
+        SocketStreamBuf(const SocketStreamBuf&);
+
+        //- Disallow default bitwise assignment
+        void operator=(const SocketStreamBuf&);
+
+
+protected:
+
+    // Protected Member Functions
+
+        //- Write the buffer when full
+        virtual int_type overflow(int_type c);
+
+        //- Buffer small output, write large output directly
+        virtual std::streamsize xsputn(const char* s, std::streamsize num);
+
+        //- Write the buffer, unless held
+        virtual int sync();
+
+
+public:
+
+    // Constructors
+
+        //- Construct for the socket with the given buffer size
+        SocketStreamBuf(int fd, size_t bufferSize);
+
+
+    //- Destructor, writes any remaining output
+    virtual ~SocketStreamBuf();
+
+
+    // Member Functions
+
+        //- The output not yet written
+        const char* pending() const
+        {
+            return pbase();
+        }
+
+        //- The size of the output not yet written
+        size_t nPending() const
+        {
+            return pptr() - pbase();
+        }
+
+        //- Hold the output or write it as usual again
+        void hold(bool val)
+        {
+            hold_ = val;
+        }
+
+        //- Keep what the socket does not take in the backlog,
+        //  or wait for the socket (NULL)
+        void backlog(SocketOutput* out)
+        {
+            backlog_ = out;
+        }
+
+        //- The size of the file or data to be sent after the held output
+        size_t nPendingTail() const
+        {
+            return tailLen_;
+        }
+
+        //- Send part of a file, after the output so far.
+        //  The owner, if any, is kept until the file has been sent.
+        bool sendfile
+        (
+            int fd,
+            off_t offset,
+            size_t len,
+            const RefCount* owner = NULL
+        );
+
+        //- Send data without copying it, after the output so far.
+        //  The owner, if any, is kept until the data has been sent.
+        bool sendBuffer
+        (
+            const char* data,
+            size_t len,
+            const RefCount* owner = NULL
+        );
+
+        //- Write the held output, truncated to len and with the text
+        //  inserted at the given position, followed by the tail (if any).
+        //  Then discard it.
+        bool sendHeld(size_t len, size_t insertAt, const std::string& text);
+
+        //- Discard the output not yet written
+        void discard();
+
+};
+
+
+/*---------------------------------------------------------------------------*\
+                        Class SocketStream Declaration
+\*---------------------------------------------------------------------------*/
+
+class SocketStream
+:
+    public std::ostream
+{
+    // Private data
+
+        //- The stream buffer
+        SocketStreamBuf buf_;
+
+
+public:
+
+    // Static data members
+
+        //- The default buffer size
+        static size_t defaultBufferSize;
+
+
+    // Constructors
+
+        //- Construct for the socket with the given buffer size
+        explicit SocketStream(int fd, size_t bufferSize = defaultBufferSize);
+
+
+    //- Destructor, writes any remaining output
+    ~SocketStream();
+
+
+    // Member Functions
+
+        //- The output not yet written (while held)
+        const char* pending() const
+        {
+            return buf_.pending();
+        }
+
+        //- The size of the output not yet written (while held)
+        size_t nPending() const
+        {
+            return buf_.nPending();
+        }
+
+        //- Hold the output, to be inspected before it is sent.
+        //  The output is then either sent by release() or written
+        //  separately and discarded
+        void hold()
+        {
+            buf_.hold(true);
+        }
+
+        //- Stop holding the output and write it
+        void release()
+        {
+            buf_.hold(false);
+            this->flush();
+        }
+
+        //- Keep what a non-blocking socket does not take in the backlog
+        //  instead of waiting for it, or wait again (NULL)
+        void backlog(SocketOutput* out)
+        {
+            buf_.backlog(out);
+        }
+
+        //- The size of the file or data to be sent after the held output
+        size_t nPendingTail() const
+        {
+            return buf_.nPendingTail();
+        }
+
+        //- Send part of a file with sendfile(), after the output so far.
+        //  The owner of the file descriptor, if any, is kept until the
+        //  file has been sent.
+        bool sendfile
+        (
+            int fd,
+            off_t offset,
+            size_t len,
+            const RefCount* owner = NULL
+        )
+        {
+            return buf_.sendfile(fd, offset, len, owner);
+        }
+
+        //- Send data without copying it, after the output so far.
+        //  The owner of the data, if any, is kept until the data has
+        //  been sent.
+        bool sendBuffer
+        (
+            const char* data,
+            size_t len,
+            const RefCount* owner = NULL
+        )
+        {
+            return buf_.sendBuffer(data, len, owner);
+        }
+
+        //- Write the held output, truncated to len and with the text
+        //  inserted at the given position, followed by the tail (if any)
+        bool sendHeld(size_t len, size_t insertAt, const std::string& text)
+        {
+            return buf_.sendHeld(len, insertAt, text);
+        }
+
+        //- Discard the output not yet written
+        void discard()
+        {
+            buf_.discard();
+        }
+
+};
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+} // End namespace markutil
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#endif  // MARK_SOCKETSTREAM_H
+
+// ************************************************************************* //
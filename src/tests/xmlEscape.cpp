@@ -0,0 +1,199 @@
+/*---------------------------------*- C++ -*---------------------------------*\
+Copyright (c) 2011-2012 Mark Olesen
+-------------------------------------------------------------------------------
+License
+    This file is part of lsf-utils.
+
+    lsf-utils is free software: you can redistribute it and/or modify it under
+    the terms of the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the License,
+    or (at your option) any later version.
+
+    lsf-utils is distributed in the hope that it will be useful, but
+    WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+    or FITNESS FOR A PARTICULAR PURPOSE.
+    See the GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with lsf-utils. If not, see <http://www.gnu.org/licenses/>.
+
+Application
+    xmlEscape
+
+Description
+    microbenchmark of lsfutil::xml::String output, verifying that it
+    matches a plain character-by-character transliteration
+
+\*---------------------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <sys/time.h>
+
+#include "lsfutil/XmlUtils.hpp"
+using namespace lsfutil;
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+// the reference transliteration, one character at a time
+static std::ostream& reference(std::ostream& os, const std::string& str)
+{
+    for
+    (
+        std::string::const_iterator iter = str.begin();
+        iter != str.end();
+        ++iter
+    )
+    {
+        switch (*iter)
+        {
+            case '&':
+                os  << "&amp;";
+                break;
+            case '<':
+                os  << "&lt;";
+                break;
+            case '>':
+                os  << "&gt;";
+                break;
+            case '"':
+                os  << "&quot;";
+                break;
+            case '\'':
+                os  << "&apos;";
+                break;
+
+            default:
+                if (*iter >= 32 && *iter < 127)
+                {
+                    os  << *iter;
+                }
+                else
+                {
+                    os  << "&#" << static_cast<unsigned int>(*iter) << ';';
+                }
+                break;
+        }
+    }
+
+    return os;
+}
+
+
+// random string of the given length,
+// with roughly one special character in every 'every' characters
+static std::string randomString(size_t len, unsigned every)
+{
+    static const char special[] = "&<>\"'\t\n\x7f\xc3";
+    static const char plain[] =
+        "abcdefghijklmnopqrstuvwxyz/._-0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    std::string str(len, ' ');
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (every && rand() % every == 0)
+        {
+            str[i] = special[rand() % (sizeof(special) - 1)];
+        }
+        else
+        {
+            str[i] = plain[rand() % (sizeof(plain) - 1)];
+        }
+    }
+
+    return str;
+}
+
+
+static double now()
+{
+    struct timeval tv;
+    ::gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+
+int main(int argc, char **argv)
+{
+    std::cerr
+        << "test xml::String output\n\n";
+
+    const unsigned nIter = (argc > 1 ? atoi(argv[1]) : 1000);
+
+    // eg, short names, long paths, commands full of quotes
+    const size_t lengths[] = { 8, 40, 200, 2000 };
+    const unsigned densities[] = { 0, 200, 20, 3 };
+
+    int nFailed = 0;
+    srand(1);
+
+    for (unsigned lenI = 0; lenI < 4; ++lenI)
+    {
+        for (unsigned denI = 0; denI < 4; ++denI)
+        {
+            std::vector<std::string> input;
+            for (unsigned i = 0; i < 64; ++i)
+            {
+                input.push_back(randomString(lengths[lenI], densities[denI]));
+            }
+
+            // byte-exact output
+            std::ostringstream expected, actual;
+            for (unsigned i = 0; i < input.size(); ++i)
+            {
+                reference(expected, input[i]);
+                actual << xml::String(input[i]);
+            }
+
+            if (expected.str() != actual.str())
+            {
+                ++nFailed;
+            }
+
+            double t0 = now();
+            for (unsigned iter = 0; iter < nIter; ++iter)
+            {
+                std::ostringstream os;
+                for (unsigned i = 0; i < input.size(); ++i)
+                {
+                    reference(os, input[i]);
+                }
+            }
+
+            double t1 = now();
+            for (unsigned iter = 0; iter < nIter; ++iter)
+            {
+                std::ostringstream os;
+                for (unsigned i = 0; i < input.size(); ++i)
+                {
+                    os << xml::String(input[i]);
+                }
+            }
+            double t2 = now();
+
+            const double mb = 1e-6 * nIter * input.size() * lengths[lenI];
+
+            printf
+            (
+                "length %5u  1/%-4u special  %s  "
+                "reference %8.1f MB/s  xml::String %8.1f MB/s\n",
+                unsigned(lengths[lenI]),
+                densities[denI],
+                expected.str() == actual.str() ? "ok  " : "FAIL",
+                mb / (t1 - t0),
+                mb / (t2 - t1)
+            );
+        }
+    }
+
+    return nFailed ? 1 : 0;
+}
+
+
+// ************************************************************************* //